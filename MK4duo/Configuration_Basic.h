@@ -97,6 +97,18 @@
 // Uncomment to include more info in ok command
 //#define ADVANCED_OK
 
+/**
+ * Binary command stream
+ *
+ * Accept CRC checked binary frames (opcode + packed float/int parameters)
+ * on the serial port alongside ASCII G-code. Frames are decoded straight
+ * into the command queue already parsed, so no text parsing is needed.
+ * The host switches it on with M576 S1. See commands.h for the format.
+ * Not compatible with EMERGENCY_PARSER: the serial ISR can't tell frame
+ * payload bytes from text, and M108/M112/M410 frames would bypass it.
+ */
+//#define BINARY_PROTOCOL
+
 /**
  * Enable an emergency-command parser to intercept certain commands as they
  * enter the serial receive buffer, so they cannot be blocked.
@@ -90,6 +90,7 @@
  * ADVANCED MOTION FEATURES:
  * - Stepper auto deactivation
  * - Double / Quad Stepping
+ * - Step ring
  * - Low speed stepper
  * - Microstepping
  * - Motor's current
@@ -624,6 +625,21 @@
 /***********************************************************************/
 
 
+/***********************************************************************
+ ************************ S-curve acceleration *************************
+ ***********************************************************************
+ *                                                                     *
+ * The speed follows an S-curve instead of a straight ramp, so the     *
+ * acceleration starts and ends at zero (limited jerk).                *
+ * The time and distance of each ramp don't change, the acceleration   *
+ * in the middle of the ramp is 1.875 times the set acceleration.      *
+ * Smoother moves allow higher accelerations without ringing.          *
+ *                                                                     *
+ ***********************************************************************/
+//#define S_CURVE_ACCELERATION
+/***********************************************************************/
+
+
 /***********************************************************************
  *************************** Quick home ********************************
  ***********************************************************************
@@ -1155,6 +1171,27 @@
 // This enable the firmware to write some configuration that require frequent update, on the SD card
 //#define SD_SETTINGS                     // Uncomment to enable
 #define SD_CFG_SECONDS        300         // seconds between update
+
+// Read the printed file a buffer at a time, block aligned and with multi-block transfers,
+// instead of fetching each character through the single block cache of SdFat.
+//#define SD_READ_AHEAD
+#define SD_READ_AHEAD_SIZE 1024           // Bytes, multiple of 512. 1024 on AVR, 4096 on Due.
+
+// Collect the lines uploaded with M28 in a buffer and write them to the file in whole blocks,
+// with multi-block transfers that bypass the block cache of SdFat. The clusters of the file are
+// allocated ahead in contiguous groups and the ones not used are freed by M29.
+//#define SD_WRITE_BEHIND
+#define SD_WRITE_BEHIND_SIZE  1024        // Bytes, multiple of 512. 1024 on AVR, 4096 on Due.
+#define SD_WRITE_PREALLOCATE  65536       // Bytes allocated ahead for the file, 0 to disable.
+// Use a second 512 byte cache for the FAT on AVR too (always used on Due). Costs 512 bytes of RAM.
+//#define SD_SEPARATE_FAT_CACHE
+
+// Keep in RAM the G-code info (slicer, layer height, filament, object height) of the last
+// selected files, so selecting them again doesn't read the head and tail of the file.
+// A new file is read a piece at a time in the main loop and M23 returns at once.
+// Requires JSON_OUTPUT.
+//#define SD_GCODE_INFO_CACHE
+#define SD_GCODE_INFO_CACHE_SIZE 8        // Number of files (2-64). Costs 44 bytes each.
 /*****************************************************************************************/
 
 
@@ -1757,6 +1794,28 @@
 /***********************************************************************/
 
 
+/***********************************************************************
+ ***************************** Step ring *******************************
+ ***********************************************************************
+ *                                                                     *
+ * Only for 32 bit boards (Arduino Due).                               *
+ * The step events are computed ahead into a ring by a lower priority  *
+ * interrupt and the stepper interrupt only pulses the pins at the     *
+ * precomputed intervals. Every step is evenly spaced, without double  *
+ * or quad stepping, up to MAX_STEP_FREQUENCY.                         *
+ * Not compatible with LIN_ADVANCE, LASER, COLOR_MIXING_EXTRUDER,      *
+ * Z_LATE_ENABLE and the extruder encoders.                            *
+ *                                                                     *
+ * STEPPER_RING_SIZE is the number of step events (power of 2).        *
+ * STEPPER_RING_FREQUENCY is how often the ring is refilled (Hz).      *
+ *                                                                     *
+ ***********************************************************************/
+//#define STEPPER_RING
+#define STEPPER_RING_SIZE       256
+#define STEPPER_RING_FREQUENCY 2000
+/***********************************************************************/
+
+
 /***********************************************************************
  ************************* Low speed stepper ***************************
  ***********************************************************************
@@ -1888,12 +1947,17 @@
  ****************************************************************************************/
 // The number of linear motions that can be in the plan at any give time.
 // THE BLOCK BUFFER SIZE NEEDS TO BE A POWER OF 2, i.g. 8,16,32 because shifts
-// and ors are used to do the ring-buffering.
-// For Arduino DUE setting BLOCK BUFFER SIZE to 32
+// and ors are used to do the ring-buffering. The maximum is 128.
+// Only the blocks that can still change are replanned, so a big buffer
+// doesn't slow down the planner.
+// For Arduino DUE setting BLOCK BUFFER SIZE to 64 or 128
 #define BLOCK_BUFFER_SIZE 16
 
 // The ASCII buffer for receiving from the serial:
 #define MAX_CMD_SIZE 96
+// The command queue uses BUFSIZE * MAX_CMD_SIZE bytes of RAM.
+// Commands are queued already parsed, so a short move takes much less than
+// MAX_CMD_SIZE and two or three times BUFSIZE commands fit in the queue.
 // For Arduino DUE setting to 8
 #define BUFSIZE 4
 
@@ -1953,6 +2017,15 @@
 #define M100_FREE_MEMORY_DUMPER
 // Comment out to remove Corrupt sub-command
 #define M100_FREE_MEMORY_CORRUPTOR
+
+// Uncomment to add the M123 motion throughput counters for debug purpose.
+// Counts G-code lines, planner blocks and step events and reports the rates.
+//#define MOTION_STATS
+
+// Uncomment to add the M124 CPU cycle profiler for debug purpose.
+// Reports min/avg/max cycles of the stepper ISR, tick, idle, temperature
+// spin and planner buffer_line. On AVR the resolution is 4us (64 cycles).
+//#define CYCLE_PROFILER
 /****************************************************************************************/
 
 
@@ -2148,6 +2221,23 @@
 /*****************************************************************************************/
 
 
+/*****************************************************************************************
+ ******************************** Heater telemetry ***************************************
+ *****************************************************************************************
+ *                                                                                       *
+ * Record temperature, target and output of the heaters and the fan speeds at every      *
+ * temperature spin (100ms) in a ring buffer, to look at thermal problems after the      *
+ * fact. M156 D0 dumps it as CSV, M156 D1 as binary to the serial, M156 D2 as CSV to     *
+ * TEMP_TELEMETRY_FILE on the SD card.                                                   *
+ * RAM used: TEMP_TELEMETRY_SAMPLES * (2 + 5 * heaters + fans) bytes.                    *
+ *                                                                                       *
+ *****************************************************************************************/
+//#define TEMP_TELEMETRY
+#define TEMP_TELEMETRY_SAMPLES 100
+#define TEMP_TELEMETRY_FILE "telemtry.csv"
+/*****************************************************************************************/
+
+
 /*****************************************************************************************
  ****************************** Extend capabilities report *******************************
  *****************************************************************************************
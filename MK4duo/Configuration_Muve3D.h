@@ -341,6 +341,22 @@
 /*****************************************************************************************/
 
 
+/*****************************************************************************************
+ ********************************* Junction deviation ************************************
+ *****************************************************************************************
+ *                                                                                       *
+ * Limit the speed at the corners by junction deviation instead of jerk.                 *
+ * The corner speed is the speed on a circle tangent to both segments, at                *
+ * JUNCTION_DEVIATION_MM from the corner, with the acceleration of the move.             *
+ * Jerk is still used for E only moves and to start from a full halt.                    *
+ * Override with M205 J, M205 J0 goes back to jerk.                                      *
+ *                                                                                       *
+ *****************************************************************************************/
+//#define JUNCTION_DEVIATION
+#define JUNCTION_DEVIATION_MM 0.02 // (mm)
+/*****************************************************************************************/
+
+
 /*****************************************************************************************
  ************************************ Homing feedrate ************************************
  *****************************************************************************************/
@@ -452,6 +452,24 @@
 //#define ABL_BILINEAR_SUBDIVISION
 // Number of subdivisions between probe points
 #define BILINEAR_SUBDIVISIONS 3
+
+// Interpolate the grid with bicubic (Catmull-Rom) patches instead of bilinear ones.
+// The coefficients of each grid cell are computed once after G29, M421 or a load from EEPROM,
+// so the Z correction is smooth across the cells and costs a few multiply-adds.
+// Uses 64 bytes of RAM per grid cell. Not with ABL_BILINEAR_SUBDIVISION.
+//#define ABL_BICUBIC_INTERPOLATION
+
+// G29 K: adaptive probing of the bilinear grid. A coarse grid is probed first, then each cell
+// is probed at full density only where its center deviates from the bilinear interpolation
+// of its corners by more than the tolerance. Points are probed nearest first.
+//#define ABL_ADAPTIVE_PROBING
+#define ABL_ADAPTIVE_TOLERANCE 0.02 // (mm) Default for G29 K
+
+// G29 probes only the grid points under the print area, set by M555 or scanned from the SD file
+// being printed (Cura MINX/MAXX header or the first layer), plus a margin. The rest of the
+// stored mesh is kept. Needs a complete mesh of the same grid, saved or from a previous G29.
+//#define ABL_PRINT_AREA_PROBING
+#define ABL_PRINT_AREA_MARGIN 10    // (mm) Around the print area
 /** END AUTO_BED_LEVELING_LINEAR or AUTO_BED_LEVELING_BILINEAR **/
 
 /** START AUTO_BED_LEVELING_3POINT **/
@@ -602,6 +620,22 @@
 /*****************************************************************************************/
 
 
+/*****************************************************************************************
+ ********************************* Junction deviation ************************************
+ *****************************************************************************************
+ *                                                                                       *
+ * Limit the speed at the corners by junction deviation instead of jerk.                 *
+ * The corner speed is the speed on a circle tangent to both segments, at                *
+ * JUNCTION_DEVIATION_MM from the corner, with the acceleration of the move.             *
+ * Jerk is still used for E only moves and to start from a full halt.                    *
+ * Override with M205 J, M205 J0 goes back to jerk.                                      *
+ *                                                                                       *
+ *****************************************************************************************/
+//#define JUNCTION_DEVIATION
+#define JUNCTION_DEVIATION_MM 0.02 // (mm)
+/*****************************************************************************************/
+
+
 /*****************************************************************************************
  ************************************ Homing feedrate ************************************
  *****************************************************************************************/
@@ -93,6 +93,14 @@
 // Thermistor series resistor value in Ohms (see on your board)
 #define THERMISTOR_SERIES_RS 4700.0
 
+// Enable this to read the thermistors from a table of THERMISTOR_LUT_SIZE points,
+// built at boot and on M305 from the sensor parameters, with integer interpolation
+// instead of the Steinhart-Hart formula at every reading.
+// The points are spaced evenly from -20 to 450 degC, 48 points keep the error
+// within 0.6 degC from 0 to 400 degC. It costs 4 bytes of RAM per point and heater.
+//#define THERMISTOR_LUT
+#define THERMISTOR_LUT_SIZE 48
+
 // Enable this for support DHT sensor for temperature e Humidity DHT11, DHT21 or DHT22.
 //#define DHT_SENSOR
 // Set Type DHT 11 for DHT11, 21 for DHT21, 22 for DHT22
@@ -110,6 +118,12 @@
 //Show Temperature ADC value
 //The M105 command return, besides traditional information, the ADC value read from temperature sensors.
 //#define SHOW_TEMP_ADC_VALUES
+
+// Only for Arduino Due. The ADC converts all the analog inputs continuously
+// and the PDC (DMA) stores them in a double buffer. The averaging filters
+// are fed a whole frame at a time from the ADC interrupt, instead of one
+// reading per millisecond from the SysTick.
+//#define ADC_DMA_SCAN
 /*****************************************************************************************/
 
 
@@ -121,6 +135,14 @@
 #define TEMP_HYSTERESIS 3       // (degC) range of +/- temperatures considered "close" to the target one
 #define TEMP_WINDOW     1       // (degC) Window around target to start the residency timer x degC early.
 
+// M109-M190-M191-M192 don't block the command queue. The wait is kept as a barrier and the
+// commands that don't need the temperature (setting other heaters, homing, probing, mesh
+// load, moves without extrusion, reports, M500-M503) keep executing. The first other command,
+// or M116, waits for all the pending heaters. M108 drops the pending waits.
+// M116 S0 goes back to blocking waits, M116 S1 to async.
+// Note the bed is probed while it is still heating up.
+//#define ASYNC_HEATER_WAIT
+
 // When temperature exceeds max temp, your heater will be switched off.
 // When temperature exceeds max temp, your cooler cannot be activaed.
 // This feature exists to protect your hotend from overheating accidentally,
@@ -210,6 +232,30 @@
 /***********************************************************************/
 
 
+/***********************************************************************
+ ********************** Heater control period **************************
+ ***********************************************************************
+ *                                                                     *
+ * Every PID heater runs its PID (or MPC) at its own period instead    *
+ * of the fixed 100ms of the temperature manager.                      *
+ * Low mass hotends regulate better at 20-50ms,                        *
+ * beds and chambers are fine at 500ms or more.                        *
+ * Set the period with M301 H<heater> T<ms>, it is stored in EEPROM.   *
+ * The period can't be shorter than the time to read the sensors       *
+ * again: on AVR 8ms per analog input (25ms with 3 inputs), on DUE     *
+ * 2ms per heater, and never shorter than 10ms.                        *
+ * Bang-bang heaters keep their check interval.                        *
+ *                                                                     *
+ ***********************************************************************/
+//#define HEATER_CONTROL_SCHEDULER
+
+#define HOTEND_CONTROL_PERIOD   50  // (ms) 10 - 5000
+#define BED_CONTROL_PERIOD     500  // (ms) 10 - 5000
+#define CHAMBER_CONTROL_PERIOD 1000 // (ms) 10 - 5000
+#define COOLER_CONTROL_PERIOD  1000 // (ms) 10 - 5000
+/***********************************************************************/
+
+
 /***********************************************************************
  ********************** PID Settings - HOTEND **************************
  ***********************************************************************
@@ -241,6 +287,25 @@
 #define DEFAULT_Ki {07, 07, 07, 07}     // Ki for H0, H1, H2, H3
 #define DEFAULT_Kd {60, 60, 60, 60}     // Kd for H0, H1, H2, H3
 #define DEFAULT_Kc {100, 100, 100, 100} // heating power = Kc * (e_speed)
+
+// Model predictive temperature control for the hotends, used in place of the PID above.
+// Every 100ms a thermal model of the hotend predicts the temperature and the heater gets the
+// power needed to reach the target plus the power lost to the ambient, to the part cooling fan
+// and to the filament that the planner is about to extrude (feed-forward from the block buffer).
+// Run "M303 H0 S200 R4 U1" to measure the model of hotend 0, set values with M306.
+//#define MPC_HOTEND
+
+//                                     HotEnd{HE0,    HE1,    HE2,    HE3}
+#define MPC_HEATER_POWER                    {40.0,   40.0,   40.0,   40.0}   // Heater power at full PWM (W)
+#define MPC_BLOCK_HEAT_CAPACITY             {16.0,   16.0,   16.0,   16.0}   // Heat capacity of heater block and nozzle (J/K)
+#define MPC_AMBIENT_XFER_COEFF              {0.05,   0.05,   0.05,   0.05}   // Heat loss to the ambient with part fan off (W/K)
+#define MPC_AMBIENT_XFER_COEFF_FAN          {0.09,   0.09,   0.09,   0.09}   // Heat loss to the ambient with part fan at full speed (W/K)
+#define MPC_FILAMENT_HEAT_CAPACITY_PERMM  {0.0056, 0.0056, 0.0056, 0.0056}   // Filament heat capacity, 0.0056 for 1.75mm PLA, 0.0143 for 2.85mm PLA (J/K/mm)
+
+#define MPC_FAN_INDEX             0   // Part cooling fan blowing on the hotends, -1 for none
+#define MPC_LOOKAHEAD_TIME      1.0   // Seconds of planner buffer averaged for the extrusion feed-forward
+#define MPC_SMOOTHING_FACTOR   0.25   // Fraction of the difference between sensor and model corrected each 100ms
+#define MPC_AMBIENT_GAIN       0.05   // Fraction of that difference used to track the ambient temperature
 /***********************************************************************/
 
 
@@ -157,6 +157,9 @@
 #include "src/feature/rgbled/blinkm.h"
 #include "src/feature/rgbled/neopixel.h"
 #include "src/feature/rgbled/pca9632.h"
+#include "src/feature/motionstats/motionstats.h"
+#include "src/feature/cycleprofiler/cycleprofiler.h"
+#include "src/feature/telemetry/telemetry.h"
 
 /**
  * External libraries loading
@@ -161,11 +161,14 @@
  * M112 - Emergency stop
  * M114 - Output current position to serial port
  * M115 - Report capabilities. (Extended capabilities requires EXTENDED_CAPABILITIES_REPORT)
+ * M116 - Wait for the heater waits deferred by M109, M190, M191, M192. S<1=deferred|0=blocking> heater waits. (Requires ASYNC_HEATER_WAIT)
  * M117 - Display a message on the controller screen
  * M119 - Output Endstop status to serial port
  * M120 - Enable endstop detection
  * M121 - Disable endstop detection
  * M122 - S<1=true|0=false> Enable or disable check software endstop. (Requires MIN_SOFTWARE_ENDSTOPS or MAX_SOFTWARE_ENDSTOPS)
+ * M123 - Report motion throughput: G-code lines/s, planner blocks/s, step events/s. R reset counters. (Requires MOTION_STATS)
+ * M124 - Report CPU cycles min/avg/max and load of the ISRs and main loop tasks. R reset profile. (Requires CYCLE_PROFILER)
  * M125 - Save current position and move to pause park position. (Requires PARK_HEAD_ON_PAUSE)
  * M126 - Solenoid Air Valve Open (BariCUDA support by jmil)
  * M127 - Solenoid Air Valve Closed (BariCUDA vent to atmospheric pressure by jmil)
@@ -178,6 +181,8 @@
  * M149 - Set temperature units
  * M150 - Set Status LED Color as R<red> U<green> B<blue>. Values 0-255. (Requires BLINKM, RGB_LED, RGBW_LED, or PCA9632)
  * M155 - Auto-report temperatures with interval of S<seconds>. (Requires AUTO_REPORT_TEMPERATURES)
+ * M156 - Heater telemetry: S<bool> start/stop recording, I<spins> sample interval, R clear,
+ *          D<mode> dump 0 CSV serial, 1 binary serial, 2 CSV to SD. (Requires TEMP_TELEMETRY)
  * M163 - Set a single proportion for a mixing extruder. (Requires MIXING_EXTRUDER)
  * M164 - Save the mix as a virtual extruder. (Requires MIXING_EXTRUDER and MIXING_VIRTUAL_TOOLS)
  * M165 - Set the proportions for a mixing extruder. Use parameters ABCDHI to set the mixing factors. (Requires MIXING_EXTRUDER)
@@ -192,7 +197,7 @@
  * M202 - Set max acceleration in units/s^2 for travel moves (M202 X1000 Y1000) Unused in Marlin!!
  * M203 - Set maximum feedrate that your machine can sustain (M203 X200 Y200 Z300 E10000) in mm/sec
  * M204 - Set default acceleration: P for Printing moves, R for Retract only (no X, Y, Z) moves and T for Travel (non printing) moves (ex. M204 P800 T3000 R9000) in mm/sec^2
- * M205 -  advanced settings:  minimum travel speed S=while printing T=travel only,  B=minimum segment time X= maximum xy jerk, Z=maximum Z jerk, E=maximum E jerk
+ * M205 -  advanced settings:  minimum travel speed S=while printing T=travel only,  B=minimum segment time X= maximum xy jerk, Z=maximum Z jerk, E=maximum E jerk, J=junction deviation
  * M206 - Set additional homing offset
  * M207 - Set retract length S[positive mm] F[feedrate mm/min] Z[additional zlift/hop], stays in mm regardless of M200 setting
  * M208 - Set recover=unretract length S[positive mm surplus to the M207 S*] F[feedrate mm/min]
@@ -209,13 +214,18 @@
  * M301 - Set PID parameters P I D and C. H[heaters] H = 0-3 Hotend, H = -1 BED, H = -2 CHAMBER, H = -3 COOLER,
  *          P[float] Kp term, I[float] Ki term, D[float] Kd term
  *          With PID_ADD_EXTRUSION_RATE: C[float] Kc term, L[float] LPQ length
+ *          With HEATER_CONTROL_SCHEDULER: T[int] control period in ms
  * M302 - Allow cold extrudes, or set the minimum extrude S<temperature>.
  * M303 - PID relay autotune: H[heaters] H = 0-3 Hotend, H = -1 BED, H = -2 CHAMBER, H = -3 COOLER,
  *        S<temperature> sets the target temperature (default target temperature = 150C), C<cycles>, U<Apply result>.
+ *        With MPC_HOTEND: R4 measures the hotend model.
+ *        A autotunes all PID hotends at S, bed at B<temperature> and chamber at D<temperature> at the same time.
  * M305 - Set thermistor and ADC parameters: H[heaters] H = 0-3 Hotend, H = -1 BED, H = -2 CHAMBER, H = -3 COOLER,
  *          A[float] Thermistor resistance at 25°C, B[float] BetaK, C[float] Steinhart-Hart C coefficien, R[float] Pullup resistor value,
  *          L[int] ADC low offset correction, N[int] ADC high offset correction, P[int] Sensor Pin
  *        Set DHT sensor parameter: D0 P[int] Sensor Pin, S[int] Sensor Type (11, 21, 22).
+ * M306 - Set hotend model parameters: H[hotend], P[float] Heater power, C[float] Block heat capacity,
+ *          A[float] Ambient heat transfer fan off, F[float] Ambient heat transfer fan on, E[float] Filament heat capacity per mm (Requires MPC_HOTEND)
  * M350 - Set microstepping mode. (Requires digital microstepping pins.)
  * M351 - Toggle MS1 MS2 pins directly. (Requires digital microstepping pins.)
  * M355 - Turn case lights on/off
@@ -248,6 +258,7 @@
  * M531 - filename - Define filename being printed
  * M532 - X<percent> L<curLayer> - update current print state progress (X=0..100) and layer L
  * M540 - Use S[0|1] to enable or disable the stop print on endstop hit (requires ABORT_ON_ENDSTOP_HIT_FEATURE_ENABLED)
+ * M576 - S<1=on|0=off> Accept binary command frames on the serial port. (Requires BINARY_PROTOCOL)
  * M595 - Set hotend AD595 O<offset> and S<gain>
  * M600 - Pause for filament change X[pos] Y[pos] Z[relative lift] E[initial retract] L[later retract distance for removal]
  * M604 - Set data Extruder Encoder S[Error steps] (requires EXTRUDER ENCODER)
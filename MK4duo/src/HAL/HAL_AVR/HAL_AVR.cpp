@@ -109,6 +109,7 @@ void HAL_temp_timer_start() {
 }
 
 bool HAL::execute_100ms = false;
+volatile bool HAL::preparing_segments = false;
 
 // Return available memory
 int HAL::getFreeRam() {
@@ -262,9 +263,12 @@ void HAL::setPwmFrequency(const Pin pin, uint8_t val) {
  *  - Step the babysteps value for each axis towards 0
  *  - For PINS_DEBUGGING, monitor and report endstop pins
  *  - For ENDSTOP_INTERRUPTS_FEATURE check endstops if flagged
+ *  - Prepare the stepper segments
  */
 HAL_TEMP_TIMER_ISR {
 
+  CYCLE_PROBE(TICK);
+
   TEMP_TIMER += 64;
 
   if (printer.IsStopped()) return;
@@ -395,6 +399,14 @@ HAL_TEMP_TIMER_ISR {
     }
   #endif
 
+  // Prepare the stepper segments with the stepper ISR allowed. This ISR
+  // stays masked until the preparation is done, HAL_ENABLE_ISRs() at the
+  // end of the stepper ISR doesn't unmask it, so it never re-enters.
+  HAL::preparing_segments = true;
+  ENABLE_STEPPER_INTERRUPT();
+  stepper.prepare_segments();
+  HAL::preparing_segments = false;
+
   HAL_ENABLE_ISRs(); // re-enable ISRs
 }
 
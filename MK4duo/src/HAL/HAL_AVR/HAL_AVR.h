@@ -243,6 +243,10 @@ typedef uint16_t  ptr_int_t;
 
 #define TEMP_TIMER_FREQUENCY        ((F_CPU) / 64.0 / 64.0) // 3096 Hz
 
+// Time to read all the analog inputs again: one conversion per temperature
+// ISR and 2^OVERSAMPLENR conversions per input, 8ms per input at 16MHz
+#define HAL_ADC_REFRESH_MS          ((ANALOG_INPUTS) * (1000UL << (OVERSAMPLENR)) * 64UL * 64UL / (F_CPU) + 1)
+
 #define STEPPER_TIMER OCR1A
 #define STEPPER_TCCR  TCCR1A
 #define STEPPER_TIMSK TIMSK1
@@ -273,10 +277,11 @@ typedef uint16_t  ptr_int_t;
 #define HAL_STEP_TIMER_ISR  ISR(TIMER1_COMPA_vect)
 #define HAL_TEMP_TIMER_ISR  ISR(TIMER0_COMPB_vect)
 
+// The temperature ISR stays masked while it prepares the stepper segments
 #define HAL_ENABLE_ISRs() \
         do { \
           cli(); \
-          ENABLE_TEMP_INTERRUPT(); \
+          if (!HAL::preparing_segments) ENABLE_TEMP_INTERRUPT(); \
           ENABLE_STEPPER_INTERRUPT(); \
         } while(0)
 
@@ -371,6 +376,7 @@ class HAL {
     #endif
 
     static bool execute_100ms;
+    static volatile bool preparing_segments;
 
   public: /** Public Function */
 
@@ -491,5 +497,6 @@ class HAL {
 #define COS(x)      cos(x)
 #define SIN(x)      sin(x)
 #define LOG(x)      log(x)
+#define EXP(x)      exp(x)
 
 #endif // HAL_AVR_H
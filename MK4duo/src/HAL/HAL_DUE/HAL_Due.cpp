@@ -88,6 +88,12 @@ uint8_t MCUSR;
   ADCAveragingFilter  HAL::mcuFilter;
 #endif
 
+#if ENABLED(ADC_DMA_SCAN) && ANALOG_INPUTS > 0
+  ADCAveragingFilter* HAL::channelFilter[NUM_ANALOG_INPUTS] = { NULL };
+  uint16_t            HAL::adcBuffer[2][ADC_DMA_FRAME];
+  uint8_t             HAL::adcBufferIndex = 0;
+#endif
+
 // disable interrupts
 void cli(void) {
   noInterrupts();
@@ -269,6 +275,25 @@ uint16_t AnalogInReadPin(const Pin r_pin) {
     return 0;
 }
 
+#if ENABLED(ADC_DMA_SCAN) && ANALOG_INPUTS > 0
+
+  // Route the readings of a pin to an averaging filter
+  void AnalogInMapPin(ADCAveragingFilter* channelFilter[], const Pin r_pin, ADCAveragingFilter* filter) {
+    adc_channel_num_t adc_ch = PinToAdcChannel(r_pin);
+    if ((unsigned int)adc_ch < NUM_ANALOG_INPUTS) channelFilter[adc_ch] = filter;
+  }
+
+  /**
+   * The PDC has filled a buffer and goes on with the other one.
+   * Feed the readings to the filters, tagged with their channel,
+   * then give the buffer back to the PDC as the next one.
+   */
+  void ADC_Handler() {
+    HAL::AdcFrameDone();
+  }
+
+#endif
+
 // Initialize ADC channels
 void HAL::analogStart(void) {
 
@@ -313,34 +338,144 @@ void HAL::analogStart(void) {
     mcuFilter.Init(0);
   #endif
 
-  // Initialize ADC mode register (some of the following params are not used here)
-  // HW trigger disabled, use external Trigger, 12 bit resolution
-  // core and ref voltage stays on, normal sleep mode, normal not free-run mode
-  // startup time 16 clocks, settling time 17 clocks, no changes on channel switch
-  // convert channels in numeric order
-  // set prescaler rate  MCK/((PRESCALE+1) * 2)
-  // set tracking time  (TRACKTIM+1) * clock periods
-  // set transfer period  (TRANSFER * 2 + 3)
-  ADC->ADC_MR = ADC_MR_TRGEN_DIS | ADC_MR_TRGSEL_ADC_TRIG0 | ADC_MR_LOWRES_BITS_12 |
-                ADC_MR_SLEEP_NORMAL | ADC_MR_FWUP_OFF | ADC_MR_FREERUN_OFF |
-                ADC_MR_STARTUP_SUT64 | ADC_MR_SETTLING_AST17 | ADC_MR_ANACH_NONE |
-                ADC_MR_USEQ_NUM_ORDER |
-                ADC_MR_PRESCAL(AD_PRESCALE_FACTOR) |
-                ADC_MR_TRACKTIM(AD_TRACKING_CYCLES) |
-                ADC_MR_TRANSFER(AD_TRANSFER_CYCLES);
-
-  ADC->ADC_IER = 0;             // no ADC interrupts
-  ADC->ADC_COR = 0;             // Single-ended, no offset
-
-  // start first conversion
-  AnalogInStartConversion();
+  #if ENABLED(ADC_DMA_SCAN) && ANALOG_INPUTS > 0
+
+    AdcMapChannels();
+
+    // Free-running, the results are tagged with their channel number
+    ADC->ADC_MR = ADC_MR_TRGEN_DIS | ADC_MR_LOWRES_BITS_12 |
+                  ADC_MR_SLEEP_NORMAL | ADC_MR_FWUP_OFF | ADC_MR_FREERUN_ON |
+                  ADC_MR_STARTUP_SUT64 | ADC_MR_SETTLING_AST17 | ADC_MR_ANACH_NONE |
+                  ADC_MR_USEQ_NUM_ORDER |
+                  ADC_MR_PRESCAL(AD_PRESCALE_FACTOR) |
+                  ADC_MR_TRACKTIM(AD_TRACKING_CYCLES) |
+                  ADC_MR_TRANSFER(AD_TRANSFER_CYCLES);
+    ADC->ADC_EMR = ADC_EMR_TAG;
+    ADC->ADC_COR = 0;             // Single-ended, no offset
+
+    // Double buffer: the PDC goes on with the next buffer when one is full
+    ADC->ADC_PTCR = ADC_PTCR_RXTDIS;
+    adcBufferIndex = 0;
+    ADC->ADC_RPR  = (uint32_t)adcBuffer[0];
+    ADC->ADC_RCR  = ADC_DMA_FRAME;
+    ADC->ADC_RNPR = (uint32_t)adcBuffer[1];
+    ADC->ADC_RNCR = ADC_DMA_FRAME;
+    ADC->ADC_PTCR = ADC_PTCR_RXTEN;
+
+    ADC->ADC_IDR = ~0u;
+    ADC->ADC_IER = ADC_IER_ENDRX;
+    NVIC_SetPriority(ADC_IRQn, NvicPriorityAdc);
+    NVIC_EnableIRQ(ADC_IRQn);
+
+    // start the free-run
+    ADC->ADC_CR = ADC_CR_START;
+
+  #else
+
+    // Initialize ADC mode register (some of the following params are not used here)
+    // HW trigger disabled, use external Trigger, 12 bit resolution
+    // core and ref voltage stays on, normal sleep mode, normal not free-run mode
+    // startup time 16 clocks, settling time 17 clocks, no changes on channel switch
+    // convert channels in numeric order
+    // set prescaler rate  MCK/((PRESCALE+1) * 2)
+    // set tracking time  (TRACKTIM+1) * clock periods
+    // set transfer period  (TRANSFER * 2 + 3)
+    ADC->ADC_MR = ADC_MR_TRGEN_DIS | ADC_MR_TRGSEL_ADC_TRIG0 | ADC_MR_LOWRES_BITS_12 |
+                  ADC_MR_SLEEP_NORMAL | ADC_MR_FWUP_OFF | ADC_MR_FREERUN_OFF |
+                  ADC_MR_STARTUP_SUT64 | ADC_MR_SETTLING_AST17 | ADC_MR_ANACH_NONE |
+                  ADC_MR_USEQ_NUM_ORDER |
+                  ADC_MR_PRESCAL(AD_PRESCALE_FACTOR) |
+                  ADC_MR_TRACKTIM(AD_TRACKING_CYCLES) |
+                  ADC_MR_TRANSFER(AD_TRANSFER_CYCLES);
+
+    ADC->ADC_IER = 0;             // no ADC interrupts
+    ADC->ADC_COR = 0;             // Single-ended, no offset
+
+    // start first conversion
+    AnalogInStartConversion();
+
+  #endif
 }
 
 void HAL::AdcChangePin(const Pin old_pin, const Pin new_pin) {
   AnalogInEnablePin(old_pin, false);
   AnalogInEnablePin(new_pin, true);
+
+  #if ENABLED(ADC_DMA_SCAN) && ANALOG_INPUTS > 0
+    AdcMapChannels();
+  #endif
 }
 
+#if ENABLED(ADC_DMA_SCAN) && ANALOG_INPUTS > 0
+
+  // Rebuild the channel to filter map from the current pins
+  void HAL::AdcMapChannels() {
+    CRITICAL_SECTION_START
+      for (uint8_t ch = 0; ch < NUM_ANALOG_INPUTS; ch++) channelFilter[ch] = NULL;
+      #if HEATER_COUNT > 0
+        LOOP_HEATER() {
+          if (WITHIN(heaters[h].sensor.pin, 0, 15))
+            AnalogInMapPin(channelFilter, heaters[h].sensor.pin, &sensorFilters[h]);
+        }
+      #endif
+      #if HAS_FILAMENT_SENSOR
+        AnalogInMapPin(channelFilter, FILWIDTH_PIN, &filamentFilter);
+      #endif
+      #if HAS_POWER_CONSUMPTION_SENSOR
+        AnalogInMapPin(channelFilter, POWER_CONSUMPTION_PIN, &powerFilter);
+      #endif
+      #if HAS_MCU_TEMPERATURE
+        AnalogInMapPin(channelFilter, ADC_TEMPERATURE_SENSOR, &mcuFilter);
+      #endif
+    CRITICAL_SECTION_END
+  }
+
+  void HAL::AdcFrameDone() {
+
+    uint16_t * const frame = adcBuffer[adcBufferIndex];
+
+    for (uint16_t i = 0; i < ADC_DMA_FRAME; i++) {
+      const uint16_t reading = frame[i];
+      ADCAveragingFilter * const filter = channelFilter[reading >> 12];
+      if (filter) filter->ProcessReading(reading & 0x0FFF);
+    }
+
+    #if HEATER_COUNT > 0
+      bool all_valid = true;
+      LOOP_HEATER() {
+        if (WITHIN(heaters[h].sensor.pin, 0, 15)) {
+          if (sensorFilters[h].IsValid())
+            AnalogInputValues[heaters[h].sensor.pin] = sensorFilters[h].GetSum() / (NUM_ADC_SAMPLES >> OVERSAMPLENR);
+          else
+            all_valid = false;
+        }
+      }
+      if (all_valid) Analog_is_ready = true;
+    #endif
+
+    #if HAS_FILAMENT_SENSOR
+      if (filamentFilter.IsValid())
+        AnalogInputValues[FILWIDTH_PIN] = filamentFilter.GetSum() / (NUM_ADC_SAMPLES >> OVERSAMPLENR);
+    #endif
+
+    #if HAS_POWER_CONSUMPTION_SENSOR
+      if (powerFilter.IsValid())
+        AnalogInputValues[POWER_CONSUMPTION_PIN] = powerFilter.GetSum() / (NUM_ADC_SAMPLES >> OVERSAMPLENR);
+    #endif
+
+    #if HAS_MCU_TEMPERATURE
+      if (mcuFilter.IsValid())
+        thermalManager.mcu_current_temperature_raw = mcuFilter.GetSum();
+    #endif
+
+    // The PDC is filling the other buffer, this one comes next
+    ADC->ADC_RNPR = (uint32_t)frame;
+    ADC->ADC_RNCR = ADC_DMA_FRAME;  // Clears ENDRX
+    adcBufferIndex ^= 1;
+  }
+
+#endif
+
 // Reset peripherals and cpu
 void HAL::resetHardware() {
 
@@ -591,6 +726,8 @@ void HAL::analogWrite(Pin pin, const uint8_t value, const uint16_t freq/*=1000*/
  */
 void HAL::Tick() {
 
+  CYCLE_PROBE(TICK);
+
   static uint8_t  cycle_100ms = 0,
                   tickState = 0,
                   currentHeater = 0;
@@ -615,7 +752,12 @@ void HAL::Tick() {
   }
 
   // read analog values
-  #if ANALOG_INPUTS > 0
+  #if ENABLED(ADC_DMA_SCAN) && ANALOG_INPUTS > 0
+
+    // The ADC interrupt feeds the filters, only publish the values
+    if (HAL::Analog_is_ready) thermalManager.set_current_temp_raw();
+
+  #elif ANALOG_INPUTS > 0
 
     if (adc_get_status(ADC)) { // conversion finished?
 
@@ -148,6 +148,7 @@ typedef uint32_t  ptr_int_t;
 #define COS(x)      cosf(x)
 #define SIN(x)      sinf(x)
 #define LOG(x)      logf(x)
+#define EXP(x)      expf(x)
 
 #define CRITICAL_SECTION_START	uint32_t primask=__get_PRIMASK(); __disable_irq();
 #define CRITICAL_SECTION_END    if (!primask) __enable_irq();
@@ -193,9 +194,14 @@ typedef uint32_t  ptr_int_t;
 
 #define ABS_ZERO  -273.15
 #define NUM_ADC_SAMPLES 32
+#define ADC_DMA_FRAME   (NUM_ADC_SAMPLES * (ANALOG_INPUTS))  // Readings per DMA buffer
 #define MAX_ANALOG_PIN_NUMBER 11
 #define ADC_TEMPERATURE_SENSOR 15
 
+// Time to read all the heater sensors again: the Tick reads one sensor
+// every other millisecond, the PDC scan is never slower than that
+#define HAL_ADC_REFRESH_MS ((HEATER_COUNT) * 2)
+
 #define HARDWARE_PWM true
 // --------------------------------------------------------------------------
 // Public Variables
@@ -285,11 +291,22 @@ class HAL {
       static ADCAveragingFilter mcuFilter;
     #endif
 
+    #if ENABLED(ADC_DMA_SCAN) && ANALOG_INPUTS > 0
+      static ADCAveragingFilter* channelFilter[NUM_ANALOG_INPUTS];
+      static uint16_t adcBuffer[2][ADC_DMA_FRAME];
+      static uint8_t  adcBufferIndex;
+    #endif
+
   public: /** Public Function */
 
     static void analogStart();
     static void AdcChangePin(const Pin old_pin, const Pin new_pin);
 
+    #if ENABLED(ADC_DMA_SCAN) && ANALOG_INPUTS > 0
+      static void AdcMapChannels();
+      static void AdcFrameDone();
+    #endif
+
     static void hwSetup(void);
 
     static void analogWrite(const Pin pin, const uint8_t value, const uint16_t freq=1000);
@@ -78,6 +78,7 @@ typedef struct {
 
 #define NvicPriorityUart    1
 #define NvicPrioritySystick 2
+#define NvicPriorityAdc     4
 
 #define STEPPER_TIMER           3
 #define STEPPER_TIMER_PRESCALE  2
@@ -87,6 +88,10 @@ typedef struct {
 #define STEPPER_TIMER_TICKS_PER_US  (HAL_STEPPER_TIMER_RATE / 1000000)  // 42
 #define HAL_STEP_TIMER_ISR          void TC3_Handler()
 
+// Step preparation, at a lower priority than the stepper
+#define STEPPER_PREP_TIMER          4
+#define HAL_STEPPER_PREP_TIMER_ISR  void TC4_Handler()
+
 #define AD_PRESCALE_FACTOR      84  // 500 kHz ADC clock 
 #define AD_TRACKING_CYCLES      4   // 0 - 15     + 1 adc clock cycles
 #define AD_TRANSFER_CYCLES      1   // 0 - 3      * 2 + 3 adc clock cycles
@@ -99,6 +104,8 @@ typedef struct {
 
 #define HAL_TIMER_SET_STEPPER_COUNT(count)  HAL_timer_set_count(STEPPER_TIMER, count);
 
+#define HAL_STEPPER_PREP_TIMER_START()      HAL_timer_start(STEPPER_PREP_TIMER, STEPPER_TIMER_PRESCALE, STEPPER_PREP_FREQUENCY)
+
 #define HAL_ENABLE_ISRs() \
         do { \
           ENABLE_STEPPER_INTERRUPT(); \
@@ -165,7 +172,7 @@ static constexpr tTimerConfig TimerConfig [NUM_HARDWARE_TIMERS] = {
   { TC0, 1, TC1_IRQn, 0 },  // 1 - [servo timer1]
   { TC0, 2, TC2_IRQn, 0 },  // 2 - Pin TC 92
   { TC1, 0, TC3_IRQn, 2 },  // 3 - Stepper
-  { TC1, 1, TC4_IRQn, 0 },  // 4 -
+  { TC1, 1, TC4_IRQn, 3 },  // 4 - Step preparation
   { TC1, 2, TC5_IRQn, 0 },  // 5 - [servo timer5]
   { TC2, 0, TC6_IRQn, 0 },  // 6 - Pin TC 4 - 5
   { TC2, 1, TC7_IRQn, 0 },  // 7 - Pin TC 3 - 10
@@ -127,6 +127,9 @@
             switch (state) {
               case state_M108:
                 printer.wait_for_user = thermalManager.wait_for_heatup = false;
+                #if ENABLED(ASYNC_HEATER_WAIT)
+                  thermalManager.cancel_pending_heaters();
+                #endif
               break;
               case state_M112:
                 printer.kill(PSTR(MSG_KILLED));
@@ -43,9 +43,11 @@ Commands commands;
 long  Commands::gcode_N             = 0,
       Commands::gcode_LastN         = 0;
 
-bool Commands::send_ok[BUFSIZE];
+uint8_t Commands::command_buffer[CMD_BUFFER_SIZE] __attribute__((aligned(4)));
 
-char Commands::command_queue[BUFSIZE][MAX_CMD_SIZE];
+#if ENABLED(BINARY_PROTOCOL)
+  bool Commands::binary_mode = false;
+#endif
 
 // Inactivity shutdown
 millis_t Commands::previous_cmd_ms = 0;
@@ -56,16 +58,20 @@ millis_t Commands::previous_cmd_ms = 0;
 
 /**
  * GCode Command Queue
- * A simple ring buffer of BUFSIZE command strings.
+ * A ring buffer of variable size command records.
  *
- * Commands are copied into this buffer by the command injectors
+ * Commands are parsed and packed into this buffer by the command injectors
  * (immediate, serial, sd card) and they are processed sequentially by
- * the main loop. The process_next_command function parses the next
- * command and hands off execution to individual handler functions.
+ * the main loop. The process_next_command function loads the next
+ * command into the parser and hands off execution to individual handler
+ * functions. Lines that can't be packed are stored and parsed as text.
  */
-uint8_t Commands::commands_in_queue       = 0,  // Count of commands in the queue
-        Commands::cmd_queue_index_r       = 0,  // Ring buffer read position
-        Commands::cmd_queue_index_w       = 0;  // Ring buffer write position
+uint8_t   Commands::commands_in_queue = 0;  // Count of commands in the queue
+
+uint16_t  Commands::cmd_buffer_r      = 0,  // Ring buffer read position
+          Commands::cmd_buffer_w      = 0;  // Ring buffer write position
+
+bool      Commands::upload_pending    = false;
 
 int Commands::serial_count = 0;
 
@@ -76,6 +82,12 @@ int Commands::serial_count = 0;
  */
 const char *Commands::injected_commands_P = NULL;
 
+#if ENABLED(BINARY_PROTOCOL)
+  uint8_t   Commands::binary_frame[BINARY_FRAME_SIZE],
+            Commands::binary_count    = 0;
+  millis_t  Commands::binary_frame_ms = 0;
+#endif
+
 /**
  * Public Function
  */
@@ -109,14 +121,30 @@ void Commands::get_serial_commands() {
     }
   #endif
 
+  #if ENABLED(BINARY_PROTOCOL)
+    // Drop a frame that stopped arriving and ask for it again
+    if (binary_count && ELAPSED(millis(), binary_frame_ms + BINARY_FRAME_TIMEOUT)) {
+      binary_count = 0;
+      gcode_line_error(PSTR(MSG_ERR_BINARY_FRAME));
+    }
+  #endif
+
   /**
    * Loop while serial characters are incoming and the queue is not full
    */
   int c;
-  while (commands_in_queue < BUFSIZE && (c = MKSERIAL.read()) >= 0) {
+  while (queue_has_room() && (c = MKSERIAL.read()) >= 0) {
 
     char serial_char = c;
 
+    #if ENABLED(BINARY_PROTOCOL)
+      // A sync byte at the start of a line begins a binary frame
+      if (binary_count || (binary_mode && !serial_count && c == BINARY_FRAME_SYNC)) {
+        get_binary_byte(c);
+        continue;
+      }
+    #endif
+
     /**
      * If the character ends the line
      */
@@ -188,6 +216,9 @@ void Commands::get_serial_commands() {
         // If command was e-stop process now
         if (strcmp(command, "M108") == 0) {
           thermalManager.wait_for_heatup = false;
+          #if ENABLED(ASYNC_HEATER_WAIT)
+            thermalManager.cancel_pending_heaters();
+          #endif
           #if ENABLED(ULTIPANEL)
             printer.wait_for_user = false;
           #endif
@@ -219,6 +250,154 @@ void Commands::get_serial_commands() {
   } // queue has space, serial has data
 }
 
+#if ENABLED(BINARY_PROTOCOL)
+
+  static uint16_t crc16_ccitt(const uint8_t *p, uint8_t len) {
+    uint16_t crc = 0xFFFF;
+    while (len--) {
+      crc ^= (uint16_t)*p++ << 8;
+      for (uint8_t i = 0; i < 8; i++)
+        crc = (crc & 0x8000) ? (crc << 1) ^ 0x1021 : crc << 1;
+    }
+    return crc;
+  }
+
+  /**
+   * Collect one byte of a binary frame. When the frame is complete
+   * check it and decode it straight into the next command queue slot.
+   */
+  void Commands::get_binary_byte(const uint8_t c) {
+
+    binary_frame[binary_count++] = c;
+    binary_frame_ms = millis();
+
+    if (binary_count == 2 && (c < 8 || c > BINARY_FRAME_SIZE - 4)) {
+      binary_count = 0;
+      gcode_line_error(PSTR(MSG_ERR_BINARY_FRAME));
+      return;
+    }
+
+    if (binary_count < 2 || binary_count < binary_frame[1] + 4) return;
+
+    // Frame complete
+    binary_count = 0;
+
+    const uint8_t len = binary_frame[1];
+    const uint16_t crc = binary_frame[len + 2] | (binary_frame[len + 3] << 8);
+    if (crc16_ccitt(&binary_frame[1], len + 1) != crc) {
+      gcode_line_error(PSTR(MSG_ERR_CHECKSUM_MISMATCH));
+      return;
+    }
+
+    packed_command_t packed;
+    packed_command_t * const pc = &packed;
+    const int8_t count = unpack_binary_frame(&binary_frame[2], len, pc);
+    if (count < 0) {
+      gcode_line_error(PSTR(MSG_ERR_BINARY_FRAME));
+      return;
+    }
+
+    const bool M110 = pc->letter == 'M' && pc->codenum == 110;
+
+    if (pc->flags & PACKED_HAS_LINE) {
+      gcode_N = pc->line;
+      if (gcode_N != gcode_LastN + 1 && !M110) {
+        gcode_line_error(PSTR(MSG_ERR_LINE_NO));
+        return;
+      }
+      gcode_LastN = gcode_N;
+    }
+
+    // Movement commands alert when stopped
+    if (printer.IsStopped() && pc->letter == 'G' && pc->codenum <= 3) {
+      SERIAL_LM(ER, MSG_ERR_STOPPED);
+      LCD_MESSAGEPGM(MSG_STOPPED);
+    }
+
+    #if DISABLED(EMERGENCY_PARSER)
+      // If command was e-stop process now
+      if (pc->letter == 'M' && !pc->seen_bits) {
+        if (pc->codenum == 108) {
+          thermalManager.wait_for_heatup = false;
+          #if ENABLED(ASYNC_HEATER_WAIT)
+            thermalManager.cancel_pending_heaters();
+          #endif
+          #if ENABLED(ULTIPANEL)
+            printer.wait_for_user = false;
+          #endif
+        }
+        if (pc->codenum == 112) printer.kill(PSTR(MSG_KILLED));
+        if (pc->codenum == 410) stepper.quickstop_stepper();
+      }
+    #endif
+
+    commit_command(pc, PACKED_SIZE(count), true);
+  }
+
+  /**
+   * Decode a frame payload into a packed command
+   * Return the number of values, or -1 if the payload is malformed
+   */
+  int8_t Commands::unpack_binary_frame(const uint8_t *p, const uint8_t len, packed_command_t * const pc) {
+
+    const uint8_t * const end = p + len;
+
+    pc->marker  = PACKED_CMD_MARKER;
+    pc->letter  = *p++;
+    pc->codenum = p[0] | (p[1] << 8);
+    p += 2;
+
+    switch (pc->letter) { case 'G': case 'M': case 'T': break; default: return -1; }
+
+    const uint8_t flags = *p++;
+
+    // The header length depends on the flags
+    if (end - p < 4
+        + ((flags & BINARY_FLAG_LINE)     ? 4 : 0)
+        + ((flags & BINARY_FLAG_SUBCODE)  ? 1 : 0)
+        + ((flags & BINARY_FLAG_NOVALUE)  ? 4 : 0)
+        + ((flags & BINARY_FLAG_LONG)     ? 4 : 0)
+    ) return -1;
+
+    pc->flags = 0;
+    if (flags & BINARY_FLAG_LINE) {
+      memcpy(&pc->line, p, 4);
+      p += 4;
+      pc->flags = PACKED_HAS_LINE;
+    }
+
+    pc->subcode = (flags & BINARY_FLAG_SUBCODE) ? *p++ : 0;
+
+    memcpy(&pc->seen_bits, p, 4);
+    p += 4;
+    pc->seen_bits &= PACKED_PARAM_MASK;
+
+    pc->value_bits = pc->seen_bits;
+    if (flags & BINARY_FLAG_NOVALUE) {
+      uint32_t novalue;
+      memcpy(&novalue, p, 4);
+      p += 4;
+      pc->value_bits &= ~novalue;
+    }
+
+    pc->long_bits = 0;
+    if (flags & BINARY_FLAG_LONG) {
+      memcpy(&pc->long_bits, p, 4);
+      p += 4;
+      pc->long_bits &= pc->value_bits;
+    }
+
+    // Exactly one value for each parameter that has one
+    uint8_t count = 0;
+    for (uint32_t bits = pc->value_bits; bits; bits &= bits - 1) count++;
+    if (count > PACKED_MAX_VALUES || end - p != 4 * count) return -1;
+
+    memcpy(pc->value, p, 4 * count);
+    return count;
+  }
+
+#endif // BINARY_PROTOCOL
+
 #if HAS_SDSUPPORT
 
   /**
@@ -255,8 +434,9 @@ void Commands::get_serial_commands() {
 
     if (commands_in_queue == 0) stop_buffering = false;
 
+    static char sd_line_buffer[MAX_CMD_SIZE];
     uint16_t sd_count = 0;
-    while (commands_in_queue < BUFSIZE && !card.eof() && !stop_buffering) {
+    while (queue_has_room() && !card.eof() && !stop_buffering) {
       const int16_t n = card.get();
       char sd_char = (char)n;
       if (card.eof() || n == -1
@@ -287,10 +467,10 @@ void Commands::get_serial_commands() {
 
         if (!sd_count) continue; // skip empty lines (and comment lines)
 
-        command_queue[cmd_queue_index_w][sd_count] = '\0'; // terminate string
+        sd_line_buffer[sd_count] = '\0'; // terminate string
         sd_count = 0; // clear sd line buffer
 
-        commit_command(false);
+        enqueue_command(sd_line_buffer);
       }
       else if (sd_count >= MAX_CMD_SIZE - 1) {
         /**
@@ -300,7 +480,7 @@ void Commands::get_serial_commands() {
       }
       else {
         if (sd_char == ';') sd_comment_mode = true;
-        if (!sd_comment_mode) command_queue[cmd_queue_index_w][sd_count++] = sd_char;
+        if (!sd_comment_mode) sd_line_buffer[sd_count++] = sd_char;
       }
     }
 
@@ -331,18 +511,24 @@ void Commands::flush_and_request_resend() {
  */
 void Commands::ok_to_send() {
   refresh_cmd_timeout();
-  if (!send_ok[cmd_queue_index_r]) return;
+  if (commands_in_queue && !current_record()->send_ok) return;
   SERIAL_STR(OK);
   #if ENABLED(ADVANCED_OK)
-    char* p = command_queue[cmd_queue_index_r];
-    if (*p == 'N') {
-      SERIAL_CHR(' ');
-      SERIAL_CHR(*p++);
-      while (NUMERIC_SIGNED(*p))
+    if (commands_in_queue) {
+      char* p = current_command();
+      if (*p == PACKED_CMD_MARKER) {
+        const packed_command_t * const pc = (const packed_command_t*)p;
+        if (pc->flags & PACKED_HAS_LINE) SERIAL_MV(" N", pc->line);
+      }
+      else if (*p == 'N') {
+        SERIAL_CHR(' ');
         SERIAL_CHR(*p++);
+        while (NUMERIC_SIGNED(*p))
+          SERIAL_CHR(*p++);
+      }
     }
     SERIAL_MV(" P", (int)(BLOCK_BUFFER_SIZE - planner.movesplanned() - 1));
-    SERIAL_MV(" B", BUFSIZE - commands_in_queue);
+    SERIAL_MV(" B", (int)(queue_room() / CMD_RECORD_MAX));
   #endif
   SERIAL_EOL();
 }
@@ -355,7 +541,7 @@ void Commands::ok_to_send() {
  */
 void Commands::get_available_commands() {
 
-  if (commands_in_queue >= BUFSIZE) return;
+  if (!queue_has_room()) return;
 
   // if any immediate commands remain, don't get other commands yet
   if (drain_injected_commands_P()) return;
@@ -377,8 +563,15 @@ void Commands::advance_command_queue() {
   #if HAS_SDSUPPORT
 
     if (card.saving) {
-      char* command = command_queue[cmd_queue_index_r];
-      if (strstr_P(command, PSTR("M29"))) {
+      char* command = current_command();
+      // The lines of an upload are queued as text, only binary frames are packed
+      #if ENABLED(BINARY_PROTOCOL)
+        const packed_command_t * const pc = (*command == PACKED_CMD_MARKER) ? (const packed_command_t*)command : NULL;
+        const bool is_M29 = pc ? pc->letter == 'M' && pc->codenum == 29 : strstr_P(command, PSTR("M29")) != NULL;
+      #else
+        const bool is_M29 = strstr_P(command, PSTR("M29")) != NULL;
+      #endif
+      if (is_M29) {
         // M29 closes the file
         card.finishWrite();
 
@@ -392,14 +585,25 @@ void Commands::advance_command_queue() {
 
         ok_to_send();
       }
+      #if ENABLED(BINARY_PROTOCOL)
+        else if (pc) {
+          // Binary frames have no text to write
+          SERIAL_LM(ER, MSG_ERR_BINARY_SAVING);
+          ok_to_send();
+        }
+      #endif
       else {
         // Write the string from the read buffer to SD
         card.write_command(command);
         ok_to_send();
       }
     }
-    else
+    else {
       process_next_command();
+      // An M28 that failed doesn't start an upload
+      if (upload_pending && !card.saving && parser.command_letter == 'M' && parser.codenum == 28)
+        upload_pending = false;
+    }
 
   #else // !HAS_SDSUPPORT
 
@@ -409,8 +613,13 @@ void Commands::advance_command_queue() {
 
   // The queue may be reset by a command handler or by code invoked by idle() within a handler
   if (commands_in_queue) {
-    --commands_in_queue;
-    if (++cmd_queue_index_r >= BUFSIZE) cmd_queue_index_r = 0;
+    if (--commands_in_queue) {
+      cmd_buffer_r += current_record()->size << 2;
+      // Follow the writer back to the start of the buffer
+      if (cmd_buffer_r >= CMD_BUFFER_SIZE || !current_record()->size) cmd_buffer_r = 0;
+    }
+    else
+      cmd_buffer_r = cmd_buffer_w = 0;
   }
 }
 
@@ -446,28 +655,83 @@ void Commands::enqueue_and_echo_commands_P(const char * const pgcode) {
  * Clear the MK4duo command queue
  */
 void Commands::clear_command_queue() {
-  cmd_queue_index_r = cmd_queue_index_w;
+  cmd_buffer_r = cmd_buffer_w;
   commands_in_queue = 0;
+  upload_pending = false;
+}
+
+/**
+ * Size of the largest record that can be added to the ring buffer
+ */
+uint16_t Commands::queue_room() {
+  if (!commands_in_queue) return CMD_BUFFER_SIZE;
+  if (cmd_buffer_w > cmd_buffer_r) {
+    const uint16_t tail = CMD_BUFFER_SIZE - cmd_buffer_w;
+    return tail > cmd_buffer_r ? tail : cmd_buffer_r;
+  }
+  return cmd_buffer_r - cmd_buffer_w;
 }
 
 /**
- * Once a new command is in the ring buffer, call this to commit it
+ * Copy a packed command or a command line into the ring buffer.
+ * A record never wraps, if there is no room at the end of the
+ * buffer it starts again from the beginning.
+ * Return false if the buffer is full.
  */
-void Commands::commit_command(bool say_ok) {
-  send_ok[cmd_queue_index_w] = say_ok;
-  if (++cmd_queue_index_w >= BUFSIZE) cmd_queue_index_w = 0;
+bool Commands::commit_command(const void * const data, const uint8_t len, const bool say_ok) {
+  const uint16_t size = (CMD_RECORD_HEAD + len + 3) & ~3;
+
+  if (!commands_in_queue) {
+    if (cmd_buffer_w + size > CMD_BUFFER_SIZE) cmd_buffer_r = cmd_buffer_w = 0;
+  }
+  else if (cmd_buffer_w > cmd_buffer_r) {
+    if (cmd_buffer_w + size > CMD_BUFFER_SIZE) {
+      if (cmd_buffer_r < size) return false;
+      // Tell the reader to continue at the start
+      if (cmd_buffer_w < CMD_BUFFER_SIZE) ((cmd_record_t*)&command_buffer[cmd_buffer_w])->size = 0;
+      cmd_buffer_w = 0;
+    }
+  }
+  else if (cmd_buffer_r - cmd_buffer_w < size) return false;
+
+  cmd_record_t * const record = (cmd_record_t*)&command_buffer[cmd_buffer_w];
+  record->size = size >> 2;
+  record->send_ok = say_ok;
+  memcpy(&command_buffer[cmd_buffer_w + CMD_RECORD_HEAD], data, len);
+
+  cmd_buffer_w += size;
   commands_in_queue++;
+  return true;
 }
 
 /**
- * Copy a command from RAM into the main command buffer.
+ * Parse a command from RAM and add it to the main command buffer.
  * Return true if the command was successfully added.
  * Return false for a full buffer, or if the 'command' is a comment.
  */
 bool Commands::enqueue_command(const char* cmd, bool say_ok/*=false*/) {
-  if (*cmd == ';' || commands_in_queue >= BUFSIZE) return false;
-  strcpy(command_queue[cmd_queue_index_w], cmd);
-  commit_command(say_ok);
+  if (*cmd == ';') return false;
+
+  packed_command_t packed;
+  bool M28 = false, M29 = false;
+
+  // Lines between M28 and M29 are written to the file as they are
+  if (upload_pending)
+    M29 = strstr_P(cmd, PSTR("M29")) != NULL;
+  else {
+    const int8_t count = parser.pack(cmd, &packed);
+    if (count >= 0) return commit_command(&packed, PACKED_SIZE(count), say_ok);
+    #if HAS_SDSUPPORT
+      M28 = packed.letter == 'M' && packed.codenum == 28;
+    #endif
+  }
+
+  // Keep the text for the parser
+  const size_t len = strlen(cmd) + 1;
+  if (len > MAX_CMD_SIZE || !commit_command(cmd, len, say_ok)) return false;
+
+  if (M28) upload_pending = true;
+  if (M29) upload_pending = false;
   return true;
 }
 
@@ -615,20 +879,74 @@ void Commands::unknown_command_error() {
   #define EXECUTE_G0_G1(NUM) gcode_G0_G1()
 #endif
 
+#if ENABLED(ASYNC_HEATER_WAIT)
+
+  /**
+   * Commands that can run while heaters have a deferred wait:
+   * setting and waiting heaters and fans, homing, probing, leveling,
+   * moves without extrusion, modes and reports.
+   */
+  bool Commands::heater_independent() {
+    switch (parser.command_letter) {
+      case 'G':
+        switch (parser.codenum) {
+          case 0: case 1:
+            return !parser.seen('E');
+          case 4: case 20: case 21: case 28: case 29: case 30: case 31: case 32:
+          case 33: case 42: case 90: case 91: case 92:
+            return true;
+          default: return false;
+        }
+      case 'M':
+        switch (parser.codenum) {
+          case 17: case 18: case 48: case 82: case 83: case 84:
+          case 104: case 105: case 106: case 107: case 108: case 109: case 110: case 111:
+          case 114: case 115: case 117: case 118: case 119:
+          case 140: case 141: case 142: case 155: case 190: case 191: case 192:
+          case 201: case 203: case 204: case 205: case 206: case 220: case 221:
+          case 400: case 401: case 402: case 420:
+          case 500: case 501: case 502: case 503: case 851:
+            return true;
+          default: return false;
+        }
+      default: return false;
+    }
+  }
+
+#endif // ASYNC_HEATER_WAIT
+
 /**
  * Process a single command and dispatch it to its handler
  * This is called from the main loop()
  */
 void Commands::process_next_command() {
 
-  char * const current_command = command_queue[cmd_queue_index_r];
+  char * const command = current_command();
 
-  if (DEBUGGING(ECHO)) SERIAL_LV(ECHO, current_command);
+  // Most commands were parsed when they were queued
+  const bool is_packed = (*command == PACKED_CMD_MARKER);
+  if (is_packed) parser.parse_packed((const packed_command_t*)command);
+
+  if (DEBUGGING(ECHO)) {
+    SERIAL_STR(ECHO);
+    if (is_packed) parser.print_packed(); else SERIAL_TXT(command);
+    SERIAL_EOL();
+  }
 
   KEEPALIVE_STATE(IN_HANDLER);
 
   // Parse the next command in the queue
-  parser.parse(current_command);
+  if (!is_packed) parser.parse(command);
+
+  #if ENABLED(MOTION_STATS)
+    motionstats.line_executed();
+  #endif
+
+  // Deferred heater waits are a barrier for the commands that need the temperature
+  #if ENABLED(ASYNC_HEATER_WAIT)
+    if (thermalManager.heater_wait_pending() && !heater_independent())
+      thermalManager.wait_pending_heaters();
+  #endif
 
   // Handle a known G, M, or T
   switch (parser.command_letter) {
@@ -31,6 +31,60 @@
 #ifndef _COMMANDS_H_
 #define _COMMANDS_H_
 
+/**
+ * Command queue
+ *
+ * A ring of variable size records in the RAM of BUFSIZE text lines.
+ * Each record is a 4 byte header followed by a packed_command_t holding
+ * only the values used, or by the command text for the lines that can't
+ * be packed. A short G1 takes 40 bytes instead of MAX_CMD_SIZE.
+ */
+#define CMD_BUFFER_SIZE   (BUFSIZE * (MAX_CMD_SIZE))
+#define CMD_RECORD_HEAD   4
+#define CMD_RECORD_MAX    (CMD_RECORD_HEAD + (MAX_CMD_SIZE))
+
+typedef struct {
+  uint8_t size;     // Record size in bytes / 4, 0 = continue at the buffer start
+  bool    send_ok;  // Send "ok" after the command
+  uint8_t reserved[2];
+} cmd_record_t;
+
+#if ENABLED(BINARY_PROTOCOL)
+
+  /**
+   * Binary command frame (enabled with M576 S1)
+   *
+   *  0xA5 <len> <payload: len bytes> <crc16 lo> <crc16 hi>
+   *
+   * The CRC is CRC-16/CCITT (poly 0x1021, init 0xFFFF) over <len> and
+   * the payload. All the multi byte fields are little endian.
+   *
+   * Payload:
+   *  letter      1 byte    'G', 'M' or 'T'
+   *  codenum     2 bytes
+   *  flags       1 byte    BINARY_FLAG_*
+   *  line        4 bytes   if BINARY_FLAG_LINE, checked like N<int>
+   *  subcode     1 byte    if BINARY_FLAG_SUBCODE
+   *  seen        4 bytes   parameter bitmap, bit 0 = 'A'
+   *  novalue     4 bytes   if BINARY_FLAG_NOVALUE, seen params without a value
+   *  long        4 bytes   if BINARY_FLAG_LONG, values sent as int32
+   *  values      4 bytes   each, float or int32, in letter order
+   *
+   * The sync byte can't appear in ASCII G-code, so text lines keep working
+   * in binary mode. Commands that need a string (M23, M28, M117...) must
+   * be sent as text.
+   */
+  #define BINARY_FRAME_SYNC     0xA5
+  #define BINARY_FRAME_SIZE     132
+  #define BINARY_FRAME_TIMEOUT  200
+
+  #define BINARY_FLAG_LINE      0x01
+  #define BINARY_FLAG_SUBCODE   0x02
+  #define BINARY_FLAG_NOVALUE   0x04
+  #define BINARY_FLAG_LONG      0x08
+
+#endif // BINARY_PROTOCOL
+
 class Commands {
 
   public: /** Constructor */
@@ -39,26 +93,37 @@ class Commands {
 
   public: /** Public Parameters */
 
-    static char command_queue[BUFSIZE][MAX_CMD_SIZE];
+    static uint8_t command_buffer[CMD_BUFFER_SIZE] __attribute__((aligned(4)));
 
     static long gcode_LastN;
 
+    #if ENABLED(BINARY_PROTOCOL)
+      static bool binary_mode;  // Accept binary frames on the serial port
+    #endif
+
     static millis_t previous_cmd_ms;
 
   private: /** Private Parameters */
 
     static long gcode_N;
 
-    static bool send_ok[BUFSIZE];
+    static uint8_t  commands_in_queue;  // Count of commands in the queue
 
-    static uint8_t  commands_in_queue,  // Count of commands in the queue
-                    cmd_queue_index_r,  // Ring buffer read position
-                    cmd_queue_index_w;  // Ring buffer write position
+    static uint16_t cmd_buffer_r,       // Ring buffer read position
+                    cmd_buffer_w;       // Ring buffer write position
+
+    static bool upload_pending;         // M28 queued, keep text until M29
 
     static int serial_count;
 
     static const char *injected_commands_P;
 
+    #if ENABLED(BINARY_PROTOCOL)
+      static uint8_t  binary_frame[BINARY_FRAME_SIZE],
+                      binary_count;     // Bytes of the frame received so far
+      static millis_t binary_frame_ms;  // Time of the last frame byte
+    #endif
+
   public: /** Public Function */
 
     static void flush_and_request_resend();
@@ -74,18 +139,29 @@ class Commands {
     static bool get_target_tool(const uint16_t code);
     static bool get_target_heater(int8_t &h);
 
-    FORCE_INLINE static void reset_send_ok()        { for (uint8_t i = 0; i < COUNT(send_ok); i++) send_ok[i] = true; }
     FORCE_INLINE static void refresh_cmd_timeout()  { previous_cmd_ms = millis(); }
 
   private: /** Private Function */
 
     static void get_serial_commands();
+    #if ENABLED(BINARY_PROTOCOL)
+      static void get_binary_byte(const uint8_t c);
+      static int8_t unpack_binary_frame(const uint8_t *p, const uint8_t len, packed_command_t * const pc);
+    #endif
     #if HAS_SDSUPPORT
       static void get_sdcard_commands();
     #endif
 
     static void process_next_command();
-    static void commit_command(bool say_ok);
+    #if ENABLED(ASYNC_HEATER_WAIT)
+      static bool heater_independent();
+    #endif
+    static bool commit_command(const void * const data, const uint8_t len, const bool say_ok);
+    static uint16_t queue_room();
+
+    FORCE_INLINE static bool queue_has_room() { return queue_room() >= CMD_RECORD_MAX; }
+    FORCE_INLINE static cmd_record_t* current_record() { return (cmd_record_t*)&command_buffer[cmd_buffer_r]; }
+    FORCE_INLINE static char* current_command() { return (char*)&command_buffer[cmd_buffer_r + CMD_RECORD_HEAD]; }
     static void unknown_command_error();
     static void gcode_line_error(const char* err, const bool doFlush=true);
 
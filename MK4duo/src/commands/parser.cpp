@@ -57,6 +57,10 @@ uint16_t GCodeParser::codenum;
   char *GCodeParser::command_args; // start of parameters
 #endif
 
+const packed_command_t *GCodeParser::packed;  // packed command in use
+bool GCodeParser::value_is_long;
+char GCodeParser::packed_name[8];
+
 // Create a global instance of the GCodeParser singleton
 GCodeParser parser;
 
@@ -77,6 +81,7 @@ void GCodeParser::reset() {
     ZERO(codebits);                   // No codes yet
     //ZERO(param);                    // No parameters (should be safe to comment out this line)
   #endif
+  packed = NULL;                    // Text command
 }
 // Populate all fields by parsing a single line of GCode
 // 58 bytes of SRAM are used to speed up seen/value
@@ -228,6 +233,185 @@ void GCodeParser::parse(char *p) {
   }
 }
 
+/**
+ * Parse a line of GCode into a packed command when it is queued,
+ * so process_next_command() doesn't need to parse it again.
+ *
+ * Uses the same rules as the fast parser: parameters are uppercase A-Z
+ * and a value stops at 'E'. Lines the packed form can't hold are left
+ * to the text parser: commands with a string argument, unexpected
+ * characters, repeated parameters or too many values.
+ *
+ * The parser state is not touched, so a command may be queued
+ * while another one is running.
+ */
+int8_t GCodeParser::pack(const char *p, packed_command_t * const pc) {
+
+  pc->marker = PACKED_CMD_MARKER;
+  pc->letter = '?';
+  pc->subcode = pc->flags = 0;
+  pc->codenum = pc->reserved = 0;
+  pc->seen_bits = pc->value_bits = pc->long_bits = 0;
+
+  // Skip spaces
+  while (*p == ' ') ++p;
+
+  // Keep N[-0-9] for the "ok" reply
+  if (*p == 'N' && NUMERIC_SIGNED(p[1])) {
+    pc->line = strtol(p + 1, NULL, 10);
+    pc->flags = PACKED_HAS_LINE;
+    p += 2;                   // skip N[-0-9]
+    while (NUMERIC(*p)) ++p;  // skip [0-9]*
+    while (*p == ' ') ++p;    // skip [ ]*
+  }
+
+  // The command letter must be G, M, or T
+  const char letter = *p++;
+  switch (letter) { case 'G': case 'M': case 'T': break; default: return -1; }
+
+  // Skip spaces to get the numeric part
+  while (*p == ' ') ++p;
+
+  // Bail if there's no command code number
+  if (!NUMERIC(*p)) return -1;
+
+  uint16_t code = 0;
+  do {
+    code *= 10, code += *p++ - '0';
+  } while (NUMERIC(*p));
+
+  pc->letter = letter;
+  pc->codenum = code;
+
+  if (*p == '.') {
+    #if USE_GCODE_SUBCODES
+      p++;
+      while (NUMERIC(*p))
+        pc->subcode *= 10, pc->subcode += *p++ - '0';
+    #else
+      return -1;
+    #endif
+  }
+
+  // Commands that take a string argument stay as text
+  if (letter == 'M') switch (code) {
+    case 0: case 1: case 23: case 28: case 30: case 32: case 34:
+    case 117: case 118: case 531: case 928: return -1;
+    default: break;
+  }
+  else if (letter == 'G' && code == 7) return -1;
+
+  int8_t count = 0;
+  for (;;) {
+
+    while (*p == ' ') ++p;
+
+    const char c = *p++;
+    if (c == '\0' || c == '*') break;               // End of line or checksum
+    if (!WITHIN(c, 'A', 'Z')) return -1;            // Only A-Z
+
+    const uint32_t bit = PACKED_BIT(c);
+    if (pc->seen_bits & bit) return -1;             // Repeated parameter
+    pc->seen_bits |= bit;
+
+    while (*p == ' ') ++p;                          // skip spaces between parameters & values
+    if (!DECIMAL_SIGNED(*p)) continue;              // No value
+
+    if (count >= PACKED_MAX_VALUES) return -1;
+
+    // Copy the number. Stopping at 'E' prevents scientific notation.
+    char num[16];
+    uint8_t n = 0;
+    bool is_float = false;
+    for (; DECIMAL_SIGNED(*p); ++p) {
+      if (*p == '.') is_float = true;
+      if (n >= sizeof(num) - 1) return -1;         // Too long for the packed form
+      num[n++] = *p;
+    }
+    num[n] = '\0';
+
+    // Values are kept in letter order
+    uint32_t before = pc->value_bits & (bit - 1);
+    uint8_t index = 0;
+    for (; before; before &= before - 1) index++;
+    for (uint8_t i = count; i > index; i--) pc->value[i] = pc->value[i - 1];
+    count++;
+
+    pc->value_bits |= bit;
+    if (is_float)
+      pc->value[index].f = strtod(num, NULL);
+    else {
+      pc->long_bits |= bit;
+      pc->value[index].l = num[0] == '-' ? strtol(num, NULL, 10) : (int32_t)strtoul(num, NULL, 10);
+    }
+  }
+
+  return count;
+}
+
+/**
+ * Use a command that was parsed before it was queued.
+ * Values are read straight from the packed record, so seen()
+ * and the value accessors work exactly as for a text line.
+ */
+void GCodeParser::parse_packed(const packed_command_t * const pc) {
+
+  reset();
+
+  packed = pc;
+  command_letter = pc->letter;
+  codenum = pc->codenum;
+  #if USE_GCODE_SUBCODES
+    subcode = pc->subcode;
+  #endif
+
+  // Name of the command, so it can be echoed
+  char *p = packed_name;
+  *p++ = command_letter;
+  uint16_t n = codenum, div = 10000;
+  while (div > 1 && n < div) div /= 10;
+  for (; div; div /= 10) { *p++ = '0' + n / div; n %= div; }
+  *p = '\0';
+
+  command_ptr = packed_name;
+}
+
+void GCodeParser::print_packed() {
+  SERIAL_TXT(packed_name);
+  #if USE_GCODE_SUBCODES
+    if (subcode) { SERIAL_CHR('.'); SERIAL_VAL(subcode); }
+  #endif
+  uint8_t index = 0;
+  for (char c = 'A'; c <= 'Z'; ++c) {
+    const uint32_t bit = PACKED_BIT(c);
+    if (!(packed->seen_bits & bit)) continue;
+    SERIAL_CHR(' ');
+    SERIAL_CHR(c);
+    if (packed->value_bits & bit) {
+      const packed_value_t &v = packed->value[index++];
+      if (packed->long_bits & bit) SERIAL_VAL((long)v.l); else SERIAL_VAL(v.f, 5);
+    }
+  }
+}
+
+bool GCodeParser::seen_packed(const char c) {
+  const uint8_t ind = LETTER_OFF(c);
+  if (ind >= 26) return false;              // Only A-Z
+  const uint32_t bit = 1UL << ind;
+  if (!(packed->seen_bits & bit)) return false;
+  if (packed->value_bits & bit) {
+    // Values are stored in letter order, count the ones before this
+    uint32_t before = packed->value_bits & (bit - 1);
+    uint8_t index = 0;
+    for (; before; before &= before - 1) index++;
+    value_ptr = (char*)&packed->value[index];
+    value_is_long = packed->long_bits & bit;
+  }
+  else
+    value_ptr = NULL;
+  return true;
+}
+
 Pin GCodeParser::value_pin() {
   const Pin pin = (int8_t)value_int();
   return printer.pin_is_protected(pin) ? NoPin : pin;
@@ -236,7 +420,8 @@ Pin GCodeParser::value_pin() {
 #if ENABLED(DEBUG_GCODE_PARSER)
 
   void GCodeParser::debug() {
-    SERIAL_MV("Command: ", command_ptr);
+    SERIAL_MSG("Command: ");
+    if (packed) print_packed(); else SERIAL_TXT(command_ptr);
     SERIAL_MV(" (", command_letter);
     SERIAL_VAL(codenum);
     SERIAL_EM(")");
@@ -245,7 +430,13 @@ Pin GCodeParser::value_pin() {
       for (char c = 'A'; c <= 'Z'; ++c)
         if (seen(c)) { SERIAL_CHR(c); SERIAL_CHR(' '); }
     #else
-      SERIAL_MV(" args: \"", command_args);
+      SERIAL_MSG(" args: \"");
+      if (packed) {
+        for (char c = 'A'; c <= 'Z'; ++c)
+          if (seen(c)) { SERIAL_CHR(c); SERIAL_CHR(' '); }
+      }
+      else
+        SERIAL_TXT(command_args);
     #endif
     SERIAL_MSG("\"");
     if (string_arg) {
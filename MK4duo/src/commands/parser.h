@@ -44,6 +44,41 @@ typedef enum {
   TEMPUNIT_F
 } TempUnit;
 
+/**
+ * Packed (pre-parsed) command
+ *
+ * Commands are parsed when they are queued and stored in this form in
+ * place of their text. The first byte is PACKED_CMD_MARKER, which can
+ * never start a text command line. Parameters are A-Z bitmaps (bit 0 = 'A');
+ * values are stored in letter order, only for parameters that have one,
+ * as float or as long. Only the used part of value[] is queued.
+ */
+#define PACKED_CMD_MARKER   0x01
+#define PACKED_HAS_LINE     0x01
+#define PACKED_PARAM_MASK   0x03FFFFFFUL
+#define PACKED_BIT(L)       (1UL << LETTER_OFF(L))
+#define PACKED_MAX_VALUES   ((MAX_CMD_SIZE - 24) / 4)
+#define PACKED_SIZE(N)      (sizeof(packed_command_t) - (PACKED_MAX_VALUES - (N)) * sizeof(packed_value_t))
+
+typedef union {
+  float   f;
+  int32_t l;
+} packed_value_t;
+
+typedef struct {
+  char            marker,           // PACKED_CMD_MARKER
+                  letter;           // G, M, or T
+  uint8_t         subcode,          // .1
+                  flags;            // PACKED_HAS_LINE
+  uint16_t        codenum,          // 123
+                  reserved;
+  uint32_t        seen_bits,        // Parameter exists
+                  value_bits,       // Parameter has a value
+                  long_bits;        // Value is stored as long
+  int32_t         line;             // N<int> if PACKED_HAS_LINE
+  packed_value_t  value[PACKED_MAX_VALUES];
+} packed_command_t;
+
 /**
  * Parser Gcode
  *
@@ -86,6 +121,10 @@ class GCodeParser {
 
     static char *value_ptr;       // Set by seen, used to fetch the value
 
+    static const packed_command_t *packed;  // Packed command in use, NULL for text
+    static bool value_is_long;              // Set by seen for a packed value
+    static char packed_name[8];             // "M123" text for echo and errors
+
     #if ENABLED(FASTER_GCODE_PARSER)
       static byte codebits[4];    // Parameters pre-scanned
       static uint8_t param[26];   // For A-Z, offsets into command args
@@ -127,6 +166,7 @@ class GCodeParser {
       // This allows "if (seen('A')||seen('B'))" to use the last-found value.
       // This is volatile because its side-effects are important
       static bool seen(const char c) {
+        if (packed) return seen_packed(c);
         const uint8_t ind = LETTER_OFF(c);
         if (ind >= COUNT(param)) return false; // Only A-Z
         const bool b = TEST(codebits[PARAM_IND(ind)], PARAM_BIT(ind));
@@ -134,7 +174,10 @@ class GCodeParser {
         return b;
       }
 
-      static bool seen_any() { return codebits[3] || codebits[2] || codebits[1] || codebits[0]; }
+      static bool seen_any() {
+        if (packed) return packed->seen_bits;
+        return codebits[3] || codebits[2] || codebits[1] || codebits[0];
+      }
 
       #define SEEN_TEST(L) TEST(codebits[LETTER_IND(L)], LETTER_BIT(L))
 
@@ -144,25 +187,45 @@ class GCodeParser {
       // This allows "if (seen('A')||seen('B'))" to use the last-found value.
       // p DEVE ESSERE CHAR e non CONST CHAR
       static bool seen(const char c) {
+        if (packed) return seen_packed(c);
         char *p = strchr(command_args, c);
         const bool b = !!p;
         if (b) value_ptr = DECIMAL_SIGNED(p[1]) ? &p[1] : (char*)NULL;
         return b;
       }
 
-      static bool seen_any() { return *command_args == '\0'; }
+      static bool seen_any() {
+        if (packed) return packed->seen_bits;
+        return *command_args == '\0';
+      }
 
       #define SEEN_TEST(L) !!strchr(command_args, L)
 
     #endif // FASTER_GCODE_PARSER
 
     // Seen any axis parameter
-    static bool seen_axis() { return SEEN_TEST('X') || SEEN_TEST('Y') || SEEN_TEST('Z') || SEEN_TEST('E') ; }
+    static bool seen_axis() {
+      if (packed) return packed->seen_bits & (PACKED_BIT('X') | PACKED_BIT('Y') | PACKED_BIT('Z') | PACKED_BIT('E'));
+      return SEEN_TEST('X') || SEEN_TEST('Y') || SEEN_TEST('Z') || SEEN_TEST('E');
+    }
 
     // Populate all fields by parsing a single line of GCode
     // This uses 54 bytes of SRAM to speed up seen/value
     static void parse(char * p);
 
+    // Parse a line of GCode into a packed command, without touching the parser state.
+    // Return the number of values, or -1 if the line must be queued as text.
+    static int8_t pack(const char *p, packed_command_t * const pc);
+
+    // Populate all fields from a command that is already parsed
+    static void parse_packed(const packed_command_t * const pc);
+
+    // Print the command in use rebuilt from the packed record, for echo and debug
+    static void print_packed();
+
+    // Code seen bit was set in the packed command
+    static bool seen_packed(const char c);
+
     // Code value pointer was set
     FORCE_INLINE static bool has_value() { return value_ptr != NULL; }
 
@@ -171,6 +234,7 @@ class GCodeParser {
 
     // Float removes 'E' to prevent scientific notation interpretation
     inline static float value_float() {
+      if (packed) return !value_ptr ? 0.0 : value_is_long ? (float)packed_value()->l : packed_value()->f;
       if (value_ptr) {
         char *e = value_ptr;
         for (;;) {
@@ -190,8 +254,9 @@ class GCodeParser {
     }
 
     // Code value as a long or ulong
-    inline static int32_t   value_long()  { return value_ptr ? strtol(value_ptr, NULL, 10) : 0L; }
-    inline static uint32_t  value_ulong() { return value_ptr ? strtoul(value_ptr, NULL, 10) : 0UL; }
+    FORCE_INLINE static const packed_value_t* packed_value() { return (const packed_value_t*)value_ptr; }
+    inline static int32_t   value_long()  { return !value_ptr ? 0L  : packed ? (value_is_long ? packed_value()->l : (int32_t)packed_value()->f) : strtol(value_ptr, NULL, 10); }
+    inline static uint32_t  value_ulong() { return !value_ptr ? 0UL : packed ? (value_is_long ? (uint32_t)packed_value()->l : (uint32_t)packed_value()->f) : strtoul(value_ptr, NULL, 10); }
 
     // Code value for use as time
     FORCE_INLINE static millis_t  value_millis()              { return value_ulong(); }
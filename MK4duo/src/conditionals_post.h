@@ -647,6 +647,15 @@
   #define DOUBLE_STEP_FREQUENCY 10000
 #endif
 
+/**
+ * Rate of the step preparation on 32 bit boards
+ */
+#if ENABLED(STEPPER_RING)
+  #define STEPPER_PREP_FREQUENCY STEPPER_RING_FREQUENCY
+#else
+  #define STEPPER_PREP_FREQUENCY 2000
+#endif
+
 /**
  * MAX_STEP_FREQUENCY differs for TOSHIBA
  */
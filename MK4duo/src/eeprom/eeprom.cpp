@@ -38,10 +38,10 @@
 
 #include "../../MK4duo.h"
 
-#define EEPROM_VERSION "MKV42"
+#define EEPROM_VERSION "MKV45"
 
 /**
- * MKV42 EEPROM Layout:
+ * MKV45 EEPROM Layout:
  *
  *  Version (char x6)
  *  EEPROM Checksum (uint16_t)
@@ -59,6 +59,7 @@
  *  M205  Y               mechanics.max_jerk[Y_AXIS]            (float)
  *  M205  Z               mechanics.max_jerk[Z_AXIS]            (float)
  *  M205  E   E0 ...      mechanics.max_jerk[E_AXIS * EXTRDURES](float x6)
+ *  M205  J               mechanics.junction_deviation_mm       (float)
  *  M206  XYZ             mechanics.home_offset                 (float x3)
  *  M218  T   XY          tools.hotend_offset                   (float x6)
  *
@@ -115,6 +116,12 @@
  *  M301  H-1 PID         Kp, Ki, Kd                            (float x3)
  *  M301  H-2 PID         Kp, Ki, Kd                            (float x3)
  *  M301  H-1 PID         Kp, Ki, Kd                            (float x3)
+ *  M301  T               heaters[h].control_period             (uint16_t x HEATER_COUNT)
+ *  M306  H   P           heaters[h].mpc_heater_power           (float x HOTENDS)
+ *  M306  H   C           heaters[h].mpc_block_heat_capacity    (float x HOTENDS)
+ *  M306  H   A           heaters[h].mpc_ambient_xfer_coeff     (float x HOTENDS)
+ *  M306  H   F           heaters[h].mpc_ambient_xfer_coeff_fan (float x HOTENDS)
+ *  M306  H   E           heaters[h].mpc_filament_heat_capacity (float x HOTENDS)
  *
  *  M305  H0              Hotend 0  Sensor parameters
  *  M305  H1              Hotend 1  Sensor parameters
@@ -371,6 +378,9 @@ void EEPROM::Postprocess() {
     EEPROM_WRITE(mechanics.min_travel_feedrate_mm_s);
     EEPROM_WRITE(mechanics.min_segment_time_us);
     EEPROM_WRITE(mechanics.max_jerk);
+    #if ENABLED(JUNCTION_DEVIATION)
+      EEPROM_WRITE(mechanics.junction_deviation_mm);
+    #endif
     #if ENABLED(WORKSPACE_OFFSETS)
       EEPROM_WRITE(mechanics.home_offset);
     #endif
@@ -494,6 +504,20 @@ void EEPROM::Postprocess() {
       EEPROM_WRITE(thermalManager.lpq_len);
     #endif
 
+    #if ENABLED(HEATER_CONTROL_SCHEDULER)
+      LOOP_HEATER() EEPROM_WRITE(heaters[h].control_period);
+    #endif
+
+    #if ENABLED(MPC_HOTEND)
+      LOOP_HOTEND() {
+        EEPROM_WRITE(heaters[h].mpc_heater_power);
+        EEPROM_WRITE(heaters[h].mpc_block_heat_capacity);
+        EEPROM_WRITE(heaters[h].mpc_ambient_xfer_coeff);
+        EEPROM_WRITE(heaters[h].mpc_ambient_xfer_coeff_fan);
+        EEPROM_WRITE(heaters[h].mpc_filament_heat_capacity);
+      }
+    #endif
+
     #if ENABLED(DHT_SENSOR)
       EEPROM_WRITE(dhtsensor.pin);
       EEPROM_WRITE(dhtsensor.type);
@@ -709,6 +733,9 @@ void EEPROM::Postprocess() {
       EEPROM_READ(mechanics.min_travel_feedrate_mm_s);
       EEPROM_READ(mechanics.min_segment_time_us);
       EEPROM_READ(mechanics.max_jerk);
+      #if ENABLED(JUNCTION_DEVIATION)
+        EEPROM_READ(mechanics.junction_deviation_mm);
+      #endif
       #if ENABLED(WORKSPACE_OFFSETS)
         EEPROM_READ(mechanics.home_offset);
       #endif
@@ -843,6 +870,23 @@ void EEPROM::Postprocess() {
         EEPROM_READ(thermalManager.lpq_len);
       #endif
 
+      #if ENABLED(HEATER_CONTROL_SCHEDULER)
+        LOOP_HEATER() {
+          EEPROM_READ(heaters[h].control_period);
+          NOLESS(heaters[h].control_period, HEATER_CONTROL_MIN_PERIOD);
+        }
+      #endif
+
+      #if ENABLED(MPC_HOTEND)
+        LOOP_HOTEND() {
+          EEPROM_READ(heaters[h].mpc_heater_power);
+          EEPROM_READ(heaters[h].mpc_block_heat_capacity);
+          EEPROM_READ(heaters[h].mpc_ambient_xfer_coeff);
+          EEPROM_READ(heaters[h].mpc_ambient_xfer_coeff_fan);
+          EEPROM_READ(heaters[h].mpc_filament_heat_capacity);
+        }
+      #endif
+
       #if ENABLED(DHT_SENSOR)
         EEPROM_READ(dhtsensor.pin);
         EEPROM_READ(dhtsensor.type);
@@ -1037,9 +1081,181 @@ void EEPROM::Postprocess() {
 
     int EEPROM::calc_num_meshes() {
       if (meshes_begin <= 0) return 0;
-      return (meshes_end - meshes_begin) / sizeof(ubl.z_values);
+      return (meshes_end - meshes_begin) / (MESH_SLOT_SIZE);
+    }
+
+    #if HAS_EEPROM_SD
+
+      // On the SD card each mesh slot is a file in the root, MESH00.BIN, MESH01.BIN...
+      // It has its own handle, as M500 stores the active mesh with EEPROM.bin still open.
+      SdFile mesh_file;
+
+      static bool open_mesh_file(const int8_t slot, const uint8_t oflag) {
+        if (!card.cardOK) return false;
+        char name[] = "MESH00.BIN";
+        name[4] += slot / 10;
+        name[5] += slot % 10;
+        return mesh_file.open(&card.root, name, oflag);
+      }
+
+    #endif
+
+    /**
+     * Write and read a mesh slot, at the end of the EEPROM or in a file on the SD card.
+     * Return true on error, like write_data and read_data.
+     */
+    bool EEPROM::write_mesh_slot(const int8_t slot, const uint8_t *data, const uint16_t size) {
+      #if HAS_EEPROM_SD
+        if (!open_mesh_file(slot, O_CREAT | O_WRITE | O_TRUNC)) return true;
+        const bool status = mesh_file.write(data, size) != size;
+        mesh_file.close();
+        return status;
+      #else
+        uint16_t crc = 0;
+        int pos = meshes_end - (slot + 1) * (MESH_SLOT_SIZE);
+        return write_data(pos, data, size, &crc);
+      #endif
     }
 
+    bool EEPROM::read_mesh_slot(const int8_t slot, uint8_t *data, const uint16_t size) {
+      #if HAS_EEPROM_SD
+        // An encoded mesh file can be shorter than the slot
+        if (!open_mesh_file(slot, O_READ)) return true;
+        const bool status = mesh_file.read(data, size) <= 0;
+        mesh_file.close();
+        return status;
+      #else
+        uint16_t crc = 0;
+        int pos = meshes_end - (slot + 1) * (MESH_SLOT_SIZE);
+        return read_data(pos, data, size, &crc);
+      #endif
+    }
+
+    #if ENABLED(UBL_ENCODED_MESHES)
+
+      #define MESH_FORMAT_16BIT 0x10  // Version 1, microns in 16 bits
+      #define MESH_FORMAT_DELTA 0x11  // Version 1, microns from the plane of the neighbors in zigzag varint
+      #define MESH_16BIT_NAN    -32768
+
+      /**
+       * Encode a mesh in a slot image. Each point is in microns, as the difference from
+       * the plane of its left, front and front-left neighbors, zigzag coded in a varint
+       * of 7 bits per byte: a smooth bed takes about a byte per point. A mesh that doesn't
+       * fit the slot that way is coded in 16 bits per point. Unprobed points are 0 in the
+       * varint code and -32768 in 16 bits.
+       * Return the size of the image, 0 if it doesn't fit the slot.
+       */
+      uint16_t EEPROM::encode_mesh(const float (&z)[GRID_MAX_POINTS_X][GRID_MAX_POINTS_Y], uint8_t *data) {
+        int32_t row[2][GRID_MAX_POINTS_X];
+        uint16_t len = MESH_HEADER_SIZE;
+
+        for (uint8_t y = 0; y < GRID_MAX_POINTS_Y && len; y++) {
+          int32_t * const cur = row[y & 1], * const prev = row[!(y & 1)];
+          for (uint8_t x = 0; x < GRID_MAX_POINTS_X && len; x++) {
+            const int32_t pred = x ? (y ? cur[x - 1] + prev[x] - prev[x - 1] : cur[x - 1]) : (y ? prev[0] : 0);
+            uint32_t code = 0;
+            if (isnan(z[x][y]))
+              cur[x] = pred;
+            else {
+              cur[x] = LROUND(z[x][y] * 1000.0);
+              const int32_t r = cur[x] - pred;
+              code = (((uint32_t)r << 1) ^ (uint32_t)(r >> 31)) + 1;
+            }
+            do {
+              if (len >= MESH_HEADER_SIZE + 2 * (GRID_MAX_POINTS) || len >= MESH_SLOT_SIZE) { len = 0; break; }
+              data[len++] = (code & 0x7F) | (code > 0x7F ? 0x80 : 0);
+              code >>= 7;
+            } while (code);
+          }
+        }
+
+        data[0] = MESH_FORMAT_DELTA;
+
+        if (!len) {
+          if (MESH_SLOT_SIZE < MESH_HEADER_SIZE + 2 * (GRID_MAX_POINTS)) return 0;
+          data[0] = MESH_FORMAT_16BIT;
+          len = MESH_HEADER_SIZE;
+          for (uint8_t y = 0; y < GRID_MAX_POINTS_Y; y++) {
+            for (uint8_t x = 0; x < GRID_MAX_POINTS_X; x++) {
+              const int16_t v = isnan(z[x][y]) ? MESH_16BIT_NAN : constrain(LROUND(z[x][y] * 1000.0), -32767, 32767);
+              data[len++] = v & 0xFF;
+              data[len++] = v >> 8;
+            }
+          }
+        }
+
+        const uint16_t size = len - (MESH_HEADER_SIZE);
+        data[1] = GRID_MAX_POINTS_X;
+        data[2] = GRID_MAX_POINTS_Y;
+        data[3] = size & 0xFF;
+        data[4] = size >> 8;
+
+        uint16_t crc = 0;
+        crc16(&crc, data, 5);
+        crc16(&crc, data + MESH_HEADER_SIZE, size);
+        data[5] = crc & 0xFF;
+        data[6] = crc >> 8;
+
+        return len;
+      }
+
+      /**
+       * Decode a slot image into a mesh. Return false, leaving the mesh
+       * unchanged, if the format, the grid size or the CRC doesn't match.
+       */
+      bool EEPROM::decode_mesh(const uint8_t *data, float (&z)[GRID_MAX_POINTS_X][GRID_MAX_POINTS_Y]) {
+        const uint16_t size = data[3] | (data[4] << 8);
+
+        if ((data[0] != MESH_FORMAT_DELTA && data[0] != MESH_FORMAT_16BIT)
+          || data[1] != GRID_MAX_POINTS_X || data[2] != GRID_MAX_POINTS_Y
+          || size > (MESH_SLOT_SIZE) - (MESH_HEADER_SIZE)
+          || (data[0] == MESH_FORMAT_16BIT && size != 2 * (GRID_MAX_POINTS))
+        ) return false;
+
+        uint16_t crc = 0;
+        crc16(&crc, data, 5);
+        crc16(&crc, data + MESH_HEADER_SIZE, size);
+        if (crc != (data[5] | (data[6] << 8))) return false;
+
+        const uint8_t *p = data + MESH_HEADER_SIZE, * const end = p + size;
+
+        if (data[0] == MESH_FORMAT_16BIT) {
+          for (uint8_t y = 0; y < GRID_MAX_POINTS_Y; y++) {
+            for (uint8_t x = 0; x < GRID_MAX_POINTS_X; x++, p += 2) {
+              const int16_t v = p[0] | (p[1] << 8);
+              z[x][y] = v == MESH_16BIT_NAN ? NAN : v * 0.001;
+            }
+          }
+          return true;
+        }
+
+        int32_t row[2][GRID_MAX_POINTS_X];
+        for (uint8_t y = 0; y < GRID_MAX_POINTS_Y; y++) {
+          int32_t * const cur = row[y & 1], * const prev = row[!(y & 1)];
+          for (uint8_t x = 0; x < GRID_MAX_POINTS_X; x++) {
+            const int32_t pred = x ? (y ? cur[x - 1] + prev[x] - prev[x - 1] : cur[x - 1]) : (y ? prev[0] : 0);
+            uint32_t code = 0;
+            for (uint8_t shift = 0; ; shift += 7) {
+              if (p >= end || shift > 28) return false;
+              code |= (uint32_t)(*p & 0x7F) << shift;
+              if (!(*p++ & 0x80)) break;
+            }
+            if (code) {
+              code--;
+              cur[x] = pred + (int32_t)((code >> 1) ^ -(int32_t)(code & 1));
+              z[x][y] = cur[x] * 0.001;
+            }
+            else {
+              cur[x] = pred;
+              z[x][y] = NAN;
+            }
+          }
+        }
+        return p == end;
+      }
+
+    #endif // UBL_ENCODED_MESHES
+
     void EEPROM::store_mesh(int8_t slot) {
 
       #if ENABLED(AUTO_BED_LEVELING_UBL)
@@ -1054,10 +1270,17 @@ void EEPROM::Postprocess() {
           return;
         }
 
-        uint16_t crc = 0;
-        int pos = meshes_end - (slot + 1) * sizeof(ubl.z_values);
-
-        bool status = write_data(pos, (uint8_t *)&ubl.z_values, sizeof(ubl.z_values), &crc);
+        #if ENABLED(UBL_ENCODED_MESHES)
+          uint8_t data[MESH_SLOT_SIZE];
+          const uint16_t size = encode_mesh(ubl.z_values, data);
+          if (!size) {
+            SERIAL_MSG("?Mesh doesn't fit the slot.\n");
+            return;
+          }
+          bool status = write_mesh_slot(slot, data, size);
+        #else
+          bool status = write_mesh_slot(slot, (uint8_t *)&ubl.z_values, sizeof(ubl.z_values));
+        #endif
 
         if (status)
           SERIAL_MSG("?Unable to save mesh data.\n");
@@ -1087,11 +1310,14 @@ void EEPROM::Postprocess() {
           return;
         }
 
-        uint16_t crc = 0;
-        int pos = meshes_end - (slot + 1) * sizeof(ubl.z_values);
-        uint8_t * const dest = into ? (uint8_t*)into : (uint8_t*)&ubl.z_values;
-
-        bool status = read_data(pos, dest, sizeof(ubl.z_values), &crc);
+        #if ENABLED(UBL_ENCODED_MESHES)
+          typedef float mesh_t[GRID_MAX_POINTS_X][GRID_MAX_POINTS_Y];
+          uint8_t data[MESH_SLOT_SIZE];
+          bool status = read_mesh_slot(slot, data, MESH_SLOT_SIZE) || !decode_mesh(data, into ? *(mesh_t*)into : ubl.z_values);
+        #else
+          uint8_t * const dest = into ? (uint8_t*)into : (uint8_t*)&ubl.z_values;
+          bool status = read_mesh_slot(slot, dest, sizeof(ubl.z_values));
+        #endif
 
         if (status)
           SERIAL_MSG("?Unable to load mesh data.\n");
@@ -1131,6 +1357,14 @@ void EEPROM::Factory_Settings() {
                         tmp8[] PROGMEM  = DEFAULT_Kd,
                         tmp9[] PROGMEM  = DEFAULT_Kc;
 
+  #if ENABLED(MPC_HOTEND)
+    static const float  mpc1[] PROGMEM  = MPC_HEATER_POWER,
+                        mpc2[] PROGMEM  = MPC_BLOCK_HEAT_CAPACITY,
+                        mpc3[] PROGMEM  = MPC_AMBIENT_XFER_COEFF,
+                        mpc4[] PROGMEM  = MPC_AMBIENT_XFER_COEFF_FAN,
+                        mpc5[] PROGMEM  = MPC_FILAMENT_HEAT_CAPACITY_PERMM;
+  #endif
+
   #if FAN_COUNT > 0
     static const Pin    tmp10[] PROGMEM = FANS_CHANNELS;
     static const int8_t tmp11[] PROGMEM = AUTO_FAN;
@@ -1183,6 +1417,9 @@ void EEPROM::Factory_Settings() {
   mechanics.max_jerk[X_AXIS] = DEFAULT_XJERK;
   mechanics.max_jerk[Y_AXIS] = DEFAULT_YJERK;
   mechanics.max_jerk[Z_AXIS] = DEFAULT_ZJERK;
+  #if ENABLED(JUNCTION_DEVIATION)
+    mechanics.junction_deviation_mm = JUNCTION_DEVIATION_MM;
+  #endif
 
   #if ENABLED(ENABLE_LEVELING_FADE_HEIGHT)
     bedlevel.z_fade_height = 0.0;
@@ -1237,6 +1474,13 @@ void EEPROM::Factory_Settings() {
         heat->Ki  = pgm_read_float(&tmp7[h < COUNT(tmp7) ? h : COUNT(tmp7) - 1]);
         heat->Kd  = pgm_read_float(&tmp8[h < COUNT(tmp8) ? h : COUNT(tmp8) - 1]);
         heat->Kc  = pgm_read_float(&tmp9[h < COUNT(tmp9) ? h : COUNT(tmp9) - 1]);
+        #if ENABLED(MPC_HOTEND)
+          heat->mpc_heater_power            = pgm_read_float(&mpc1[h < COUNT(mpc1) ? h : COUNT(mpc1) - 1]);
+          heat->mpc_block_heat_capacity     = pgm_read_float(&mpc2[h < COUNT(mpc2) ? h : COUNT(mpc2) - 1]);
+          heat->mpc_ambient_xfer_coeff      = pgm_read_float(&mpc3[h < COUNT(mpc3) ? h : COUNT(mpc3) - 1]);
+          heat->mpc_ambient_xfer_coeff_fan  = pgm_read_float(&mpc4[h < COUNT(mpc4) ? h : COUNT(mpc4) - 1]);
+          heat->mpc_filament_heat_capacity  = pgm_read_float(&mpc5[h < COUNT(mpc5) ? h : COUNT(mpc5) - 1]);
+        #endif
       }
     #endif
 
@@ -1417,6 +1661,14 @@ void EEPROM::Factory_Settings() {
       #endif
     #endif // HAS_HEATER_BED
 
+    #if ENABLED(HEATER_CONTROL_SCHEDULER)
+      constexpr uint16_t control_period[HEATER_TYPE] = { HOTEND_CONTROL_PERIOD, BED_CONTROL_PERIOD, CHAMBER_CONTROL_PERIOD, COOLER_CONTROL_PERIOD };
+      LOOP_HEATER() {
+        heaters[h].control_period = control_period[heaters[h].type];
+        NOLESS(heaters[h].control_period, HEATER_CONTROL_MIN_PERIOD);
+      }
+    #endif
+
   #endif // HEATER_COUNT > 0
 
   // Fans
@@ -1611,13 +1863,20 @@ void EEPROM::Factory_Settings() {
       }
     #endif
 
-    CONFIG_MSG_START("Advanced variables: S<min_feedrate> V<min_travel_feedrate> B<min_segment_time_us> X<max_xy_jerk> Z<max_z_jerk> T* E<max_e_jerk>");
+    #if ENABLED(JUNCTION_DEVIATION)
+      CONFIG_MSG_START("Advanced variables: S<min_feedrate> V<min_travel_feedrate> B<min_segment_time_us> X<max_xy_jerk> Z<max_z_jerk> T* E<max_e_jerk> J<junction_deviation>");
+    #else
+      CONFIG_MSG_START("Advanced variables: S<min_feedrate> V<min_travel_feedrate> B<min_segment_time_us> X<max_xy_jerk> Z<max_z_jerk> T* E<max_e_jerk>");
+    #endif
     SERIAL_SMV(CFG, "  M205 S", LINEAR_UNIT(mechanics.min_feedrate_mm_s), 3);
     SERIAL_MV(" V", LINEAR_UNIT(mechanics.min_travel_feedrate_mm_s), 3);
     SERIAL_MV(" B", mechanics.min_segment_time_us);
     SERIAL_MV(" X", LINEAR_UNIT(mechanics.max_jerk[X_AXIS]), 3);
     SERIAL_MV(" Y", LINEAR_UNIT(mechanics.max_jerk[Y_AXIS]), 3);
     SERIAL_MV(" Z", LINEAR_UNIT(mechanics.max_jerk[Z_AXIS]), 3);
+    #if ENABLED(JUNCTION_DEVIATION)
+      SERIAL_MV(" J", LINEAR_UNIT(mechanics.junction_deviation_mm), 3);
+    #endif
     #if EXTRUDERS == 1
       SERIAL_MV(" T0 E", LINEAR_UNIT(mechanics.max_jerk[E_AXIS]), 3);
     #endif
@@ -1792,6 +2051,11 @@ void EEPROM::Factory_Settings() {
       #endif
     #endif
 
+    #if ENABLED(MPC_HOTEND)
+      CONFIG_MSG_START("Hotend model:");
+      LOOP_HOTEND() heaters[h].print_MPC(h);
+    #endif
+
     #if ENABLED(FWRETRACT)
       CONFIG_MSG_START("Retract: S<length> F<units/m> Z<lift>");
       SERIAL_SMV(CFG, "  M207 S", LINEAR_UNIT(fwretract.retract_length));
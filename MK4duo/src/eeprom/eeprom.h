@@ -43,6 +43,18 @@ class EEPROM {
         const static int meshes_end = E2END - 128; // 128 is a placeholder for the size of the MAT; the MAT will always
                                                    // live at the very end of the eeprom
 
+        #if ENABLED(UBL_ENCODED_MESHES)
+          // Slot header: format, grid X and Y points, payload size, CRC
+          #define MESH_HEADER_SIZE 7
+          #if UBL_MESH_SLOT_SIZE > 0
+            #define MESH_SLOT_SIZE (UBL_MESH_SLOT_SIZE)
+          #else
+            #define MESH_SLOT_SIZE (MESH_HEADER_SIZE + 2 * (GRID_MAX_POINTS))
+          #endif
+        #else
+          #define MESH_SLOT_SIZE ((GRID_MAX_POINTS) * sizeof(float))
+        #endif
+
       #endif
     #endif
 
@@ -58,6 +70,7 @@ class EEPROM {
                                          // That can store is enabled
         FORCE_INLINE static int get_start_of_meshes() { return meshes_begin; }
         FORCE_INLINE static int get_end_of_meshes() { return meshes_end; }
+        FORCE_INLINE static int get_mesh_slot_size() { return MESH_SLOT_SIZE; }
         static int calc_num_meshes();
         static void store_mesh(int8_t slot);
         static void load_mesh(int8_t slot, void *into = 0);
@@ -83,6 +96,15 @@ class EEPROM {
       static bool write_data(int &pos, const uint8_t *value, uint16_t size, uint16_t *crc);
       static bool read_data(int &pos, uint8_t *value, uint16_t size, uint16_t *crc);
       static void crc16(uint16_t *crc, const void * const data, uint16_t cnt);
+
+      #if ENABLED(AUTO_BED_LEVELING_UBL)
+        static bool write_mesh_slot(const int8_t slot, const uint8_t *data, const uint16_t size);
+        static bool read_mesh_slot(const int8_t slot, uint8_t *data, const uint16_t size);
+        #if ENABLED(UBL_ENCODED_MESHES)
+          static uint16_t encode_mesh(const float (&z)[GRID_MAX_POINTS_X][GRID_MAX_POINTS_Y], uint8_t *data);
+          static bool decode_mesh(const uint8_t *data, float (&z)[GRID_MAX_POINTS_X][GRID_MAX_POINTS_Y]);
+        #endif
+      #endif
     #endif
 
 };
@@ -31,6 +31,12 @@
   float AutoBedLevel::bilinear_grid_factor[2],
         AutoBedLevel::z_values[GRID_MAX_POINTS_X][GRID_MAX_POINTS_Y];
 
+  #if ENABLED(ABL_PRINT_AREA_PROBING)
+    bool  AutoBedLevel::print_area_set = false;
+    float AutoBedLevel::print_area_min[2],
+          AutoBedLevel::print_area_max[2];
+  #endif
+
   /**
    * Extrapolate a single point from its neighbors
    */
@@ -147,6 +153,14 @@
       );
     }
 
+  #elif ENABLED(ABL_BICUBIC_INTERPOLATION)
+
+    float AutoBedLevel::bicubic_coeff[GRID_MAX_POINTS_X - 1][GRID_MAX_POINTS_Y - 1][4][4];
+
+  #endif
+
+  #if ENABLED(ABL_BILINEAR_SUBDIVISION) || ENABLED(ABL_BICUBIC_INTERPOLATION)
+
     #define LINEAR_EXTRAPOLATION(E, I) ((E) * 2 - (I))
 
     float AutoBedLevel::bed_level_virt_coord(const uint8_t x, const uint8_t y) {
@@ -187,6 +201,10 @@
       return z_values[x - 1][y - 1];
     }
 
+  #endif
+
+  #if ENABLED(ABL_BILINEAR_SUBDIVISION)
+
     float AutoBedLevel::bed_level_virt_cmr(const float p[4], const uint8_t i, const float t) {
       return (
           p[i-1] * -t * sq(1 - t)
@@ -231,7 +249,49 @@
       }
     }
 
-  #endif // ABL_BILINEAR_SUBDIVISION
+  #elif ENABLED(ABL_BICUBIC_INTERPOLATION)
+
+    // Cell of the cached partial evaluation in bilinear_z_offset
+    static int8_t bicubic_last_gridx = -99, bicubic_last_gridy = -99;
+
+    /**
+     * Catmull-Rom spline between p[1] and p[2] (the same curve of
+     * bed_level_virt_cmr) as the coefficients of a cubic in t.
+     */
+    void AutoBedLevel::bicubic_cmr_coeff(const float p[4], float a[4]) {
+      a[0] = p[1];
+      a[1] = 0.5 * (p[2] - p[0]);
+      a[2] = p[0] - 2.5 * p[1] + 2.0 * p[2] - 0.5 * p[3];
+      a[3] = 0.5 * (p[3] - p[0]) + 1.5 * (p[1] - p[2]);
+    }
+
+    /**
+     * Compute the bicubic patch of every grid cell from the 4x4 points
+     * around it, extrapolating past the edges of the grid.
+     */
+    void AutoBedLevel::bicubic_interpolate() {
+      for (uint8_t x = 0; x < GRID_MAX_POINTS_X - 1; x++) {
+        for (uint8_t y = 0; y < GRID_MAX_POINTS_Y - 1; y++) {
+          float p[4], col[4][4], row[4];
+
+          // Along Y for each of the four columns
+          for (uint8_t i = 0; i < 4; i++) {
+            for (uint8_t j = 0; j < 4; j++) p[j] = bed_level_virt_coord(x + i, y + j);
+            bicubic_cmr_coeff(p, col[i]);
+          }
+
+          // Then along X for each power of v
+          for (uint8_t j = 0; j < 4; j++) {
+            for (uint8_t i = 0; i < 4; i++) p[i] = col[i][j];
+            bicubic_cmr_coeff(p, row);
+            for (uint8_t i = 0; i < 4; i++) bicubic_coeff[x][y][i][j] = row[i];
+          }
+        }
+      }
+      bicubic_last_gridx = -99; // Drop the cached evaluation
+    }
+
+  #endif // ABL_BICUBIC_INTERPOLATION
 
   // Refresh after other values have been updated
   void AutoBedLevel::refresh_bed_level() {
@@ -239,6 +299,8 @@
     bilinear_grid_factor[Y_AXIS] = RECIPROCAL(bilinear_grid_spacing[Y_AXIS]);
     #if ENABLED(ABL_BILINEAR_SUBDIVISION)
       virt_interpolate();
+    #elif ENABLED(ABL_BICUBIC_INTERPOLATION)
+      bicubic_interpolate();
     #endif
   }
 
@@ -256,148 +318,143 @@
     #define ABL_BG_GRID(X,Y)  z_values[X][Y]
   #endif
 
-  // Get the Z adjustment for non-linear bed leveling
-  float AutoBedLevel::bilinear_z_offset(const float raw[XYZ]) {
+  #if ENABLED(ABL_BICUBIC_INTERPOLATION)
 
-    static float  z1, d2, z3, d4, L, D, ratio_x, ratio_y,
-                  last_x = -999.999, last_y = -999.999;
+    // Get the Z adjustment for non-linear bed leveling from the bicubic patch of the grid cell
+    float AutoBedLevel::bilinear_z_offset(const float raw[XYZ]) {
 
-    // Whole units for the grid line indices. Constrained within bounds.
-    static int8_t gridx, gridy, nextx, nexty,
-                  last_gridx = -99, last_gridy = -99;
+      // The patch evaluated in v, a cubic in u, for the last cell and Y
+      static float  a[4], last_y = -999.999;
 
-    // XY relative to the probed area
-    const float rx = raw[X_AXIS] - bilinear_start[X_AXIS],
-                ry = raw[Y_AXIS] - bilinear_start[Y_AXIS];
+      // Grid cell and ratios within it, outside the grid the edge is extended
+      float ratio_x = (raw[X_AXIS] - bilinear_start[X_AXIS]) * bilinear_grid_factor[X_AXIS],
+            ratio_y = (raw[Y_AXIS] - bilinear_start[Y_AXIS]) * bilinear_grid_factor[Y_AXIS];
 
-    if (last_x != rx) {
-      last_x = rx;
-      ratio_x = rx * ABL_BG_FACTOR(X_AXIS);
-      const float gx = constrain(FLOOR(ratio_x), 0, ABL_BG_POINTS_X - 1);
-      ratio_x -= gx;      // Subtract whole to get the ratio within the grid box
-      NOLESS(ratio_x, 0); // Never < 0.0. (> 1.0 is ok when nextx==gridx.)
-      gridx = gx;
-      nextx = min(gridx + 1, ABL_BG_POINTS_X - 1);
-    }
+      const int8_t  gridx = constrain(FLOOR(ratio_x), 0, GRID_MAX_POINTS_X - 2),
+                    gridy = constrain(FLOOR(ratio_y), 0, GRID_MAX_POINTS_Y - 2);
 
-    if (last_y != ry || last_gridx != gridx) {
+      ratio_x = constrain(ratio_x - gridx, 0.0, 1.0);
+      ratio_y = constrain(ratio_y - gridy, 0.0, 1.0);
 
-      if (last_y != ry) {
-        last_y = ry;
-        ratio_y = ry * ABL_BG_FACTOR(Y_AXIS);
-        const float gy = constrain(FLOOR(ratio_y), 0, ABL_BG_POINTS_Y - 1);
-        ratio_y -= gy;
-        NOLESS(ratio_y, 0);
-        gridy = gy;
-        nexty = min(gridy + 1, ABL_BG_POINTS_Y - 1);
+      if (last_y != ratio_y || bicubic_last_gridx != gridx || bicubic_last_gridy != gridy) {
+        last_y = ratio_y;
+        bicubic_last_gridx = gridx;
+        bicubic_last_gridy = gridy;
+        const float (&c)[4][4] = bicubic_coeff[gridx][gridy];
+        for (uint8_t i = 0; i < 4; i++)
+          a[i] = ((c[i][3] * ratio_y + c[i][2]) * ratio_y + c[i][1]) * ratio_y + c[i][0];
       }
 
-      if (last_gridx != gridx || last_gridy != gridy) {
-        last_gridx = gridx;
-        last_gridy = gridy;
-        // Z at the box corners
-        z1 = ABL_BG_GRID(gridx, gridy);       // left-front
-        d2 = ABL_BG_GRID(gridx, nexty) - z1;  // left-back (delta)
-        z3 = ABL_BG_GRID(nextx, gridy);       // right-front
-        d4 = ABL_BG_GRID(nextx, nexty) - z3;  // right-back (delta)
-      }
+      return ((a[3] * ratio_x + a[2]) * ratio_x + a[1]) * ratio_x + a[0];
+    }
 
-      // Bilinear interpolate. Needed since ry or gridx has changed.
-                  L = z1 + d2 * ratio_y;   // Linear interp. LF -> LB
-      const float R = z3 + d4 * ratio_y;   // Linear interp. RF -> RB
+  #else
 
-      D = R - L;
-    }
+    // Get the Z adjustment for non-linear bed leveling
+    float AutoBedLevel::bilinear_z_offset(const float raw[XYZ]) {
 
-    const float offset = L + ratio_x * D;   // the offset almost always changes
-
-    /*
-    static float last_offset = 0;
-    if (FABS(last_offset - offset) > 0.2) {
-      SERIAL_MSG("Sudden Shift at ");
-      SERIAL_MV("x=", rx);
-      SERIAL_MV(" / ", ABL_BG_SPACING(X_AXIS));
-      SERIAL_EMV(" -> gridx=", gridx);
-      SERIAL_MV(" y=", ry);
-      SERIAL_MV(" / ", ABL_BG_SPACING(Y_AXIS));
-      SERIAL_EMV(" -> gridy=", gridy);
-      SERIAL_MV(" ratio_x=", ratio_x);
-      SERIAL_EMV(" ratio_y=", ratio_y);
-      SERIAL_MV(" z1=", z1);
-      SERIAL_MV(" d2=", d2);
-      SERIAL_MV(" z3=", z3);
-      SERIAL_EMV(" d4=", d4);
-      SERIAL_MV(" L=", L);
-      SERIAL_MV(" R=", R);
-      SERIAL_EMV(" offset=", offset);
-    }
-    last_offset = offset;
-    */
+      static float  z1, d2, z3, d4, L, D, ratio_x, ratio_y,
+                    last_x = -999.999, last_y = -999.999;
 
-    return offset;
-  }
+      // Whole units for the grid line indices. Constrained within bounds.
+      static int8_t gridx, gridy, nextx, nexty,
+                    last_gridx = -99, last_gridy = -99;
 
-  #if !IS_KINEMATIC
+      // XY relative to the probed area
+      const float rx = raw[X_AXIS] - bilinear_start[X_AXIS],
+                  ry = raw[Y_AXIS] - bilinear_start[Y_AXIS];
 
-    /**
-     * Prepare a bilinear-leveled linear move on Cartesian,
-     * splitting the move where it crosses mesh borders.
-     */
-    void AutoBedLevel::bilinear_line_to_destination(float fr_mm_s, uint16_t x_splits/*= 0xFFFF*/, uint16_t y_splits/*= 0xFFFF*/) {
-
-      int cx1 = (mechanics.current_position[X_AXIS] - bilinear_start[X_AXIS]) * ABL_BG_FACTOR(X_AXIS),
-          cy1 = (mechanics.current_position[Y_AXIS] - bilinear_start[Y_AXIS]) * ABL_BG_FACTOR(Y_AXIS),
-          cx2 = (mechanics.destination[X_AXIS]      - bilinear_start[X_AXIS]) * ABL_BG_FACTOR(X_AXIS),
-          cy2 = (mechanics.destination[Y_AXIS]      - bilinear_start[Y_AXIS]) * ABL_BG_FACTOR(Y_AXIS);
-
-      cx1 = constrain(cx1, 0, ABL_BG_POINTS_X - 2);
-      cy1 = constrain(cy1, 0, ABL_BG_POINTS_Y - 2);
-      cx2 = constrain(cx2, 0, ABL_BG_POINTS_X - 2);
-      cy2 = constrain(cy2, 0, ABL_BG_POINTS_Y - 2);
-
-      if (cx1 == cx2 && cy1 == cy2) {
-        // Start and end on same mesh square
-        mechanics.line_to_destination(fr_mm_s);
-        mechanics.set_current_to_destination();
-        return;
+      if (last_x != rx) {
+        last_x = rx;
+        ratio_x = rx * ABL_BG_FACTOR(X_AXIS);
+        const float gx = constrain(FLOOR(ratio_x), 0, ABL_BG_POINTS_X - 1);
+        ratio_x -= gx;      // Subtract whole to get the ratio within the grid box
+        NOLESS(ratio_x, 0); // Never < 0.0. (> 1.0 is ok when nextx==gridx.)
+        gridx = gx;
+        nextx = min(gridx + 1, ABL_BG_POINTS_X - 1);
       }
 
-      #define LINE_SEGMENT_END(A) (mechanics.current_position[A ##_AXIS] + (mechanics.destination[A ##_AXIS] - mechanics.current_position[A ##_AXIS]) * normalized_dist)
+      if (last_y != ry || last_gridx != gridx) {
 
-      float normalized_dist, end[XYZE];
+        if (last_y != ry) {
+          last_y = ry;
+          ratio_y = ry * ABL_BG_FACTOR(Y_AXIS);
+          const float gy = constrain(FLOOR(ratio_y), 0, ABL_BG_POINTS_Y - 1);
+          ratio_y -= gy;
+          NOLESS(ratio_y, 0);
+          gridy = gy;
+          nexty = min(gridy + 1, ABL_BG_POINTS_Y - 1);
+        }
 
-      // Split at the left/front border of the right/top square
-      int8_t gcx = max(cx1, cx2), gcy = max(cy1, cy2);
-      if (cx2 != cx1 && TEST(x_splits, gcx)) {
-        COPY_ARRAY(end, mechanics.destination);
-        mechanics.destination[X_AXIS] = bilinear_start[X_AXIS] + ABL_BG_SPACING(X_AXIS) * gcx;
-        normalized_dist = (mechanics.destination[X_AXIS] - mechanics.current_position[X_AXIS]) / (end[X_AXIS] - mechanics.current_position[X_AXIS]);
-        mechanics.destination[Y_AXIS] = LINE_SEGMENT_END(Y);
-        CBI(x_splits, gcx);
-      }
-      else if (cy2 != cy1 && TEST(y_splits, gcy)) {
-        COPY_ARRAY(end, mechanics.destination);
-        mechanics.destination[Y_AXIS] = bilinear_start[Y_AXIS] + ABL_BG_SPACING(Y_AXIS) * gcy;
-        normalized_dist = (mechanics.destination[Y_AXIS] - mechanics.current_position[Y_AXIS]) / (end[Y_AXIS] - mechanics.current_position[Y_AXIS]);
-        mechanics.destination[X_AXIS] = LINE_SEGMENT_END(X);
-        CBI(y_splits, gcy);
+        if (last_gridx != gridx || last_gridy != gridy) {
+          last_gridx = gridx;
+          last_gridy = gridy;
+          // Z at the box corners
+          z1 = ABL_BG_GRID(gridx, gridy);       // left-front
+          d2 = ABL_BG_GRID(gridx, nexty) - z1;  // left-back (delta)
+          z3 = ABL_BG_GRID(nextx, gridy);       // right-front
+          d4 = ABL_BG_GRID(nextx, nexty) - z3;  // right-back (delta)
+        }
+
+        // Bilinear interpolate. Needed since ry or gridx has changed.
+                    L = z1 + d2 * ratio_y;   // Linear interp. LF -> LB
+        const float R = z3 + d4 * ratio_y;   // Linear interp. RF -> RB
+
+        D = R - L;
       }
-      else {
-        // Already split on a border
-        mechanics.line_to_destination(fr_mm_s);
-        mechanics.set_current_to_destination();
-        return;
+
+      const float offset = L + ratio_x * D;   // the offset almost always changes
+
+      /*
+      static float last_offset = 0;
+      if (FABS(last_offset - offset) > 0.2) {
+        SERIAL_MSG("Sudden Shift at ");
+        SERIAL_MV("x=", rx);
+        SERIAL_MV(" / ", ABL_BG_SPACING(X_AXIS));
+        SERIAL_EMV(" -> gridx=", gridx);
+        SERIAL_MV(" y=", ry);
+        SERIAL_MV(" / ", ABL_BG_SPACING(Y_AXIS));
+        SERIAL_EMV(" -> gridy=", gridy);
+        SERIAL_MV(" ratio_x=", ratio_x);
+        SERIAL_EMV(" ratio_y=", ratio_y);
+        SERIAL_MV(" z1=", z1);
+        SERIAL_MV(" d2=", d2);
+        SERIAL_MV(" z3=", z3);
+        SERIAL_EMV(" d4=", d4);
+        SERIAL_MV(" L=", L);
+        SERIAL_MV(" R=", R);
+        SERIAL_EMV(" offset=", offset);
       }
+      last_offset = offset;
+      */
 
-      mechanics.destination[Z_AXIS] = LINE_SEGMENT_END(Z);
-      mechanics.destination[E_AXIS] = LINE_SEGMENT_END(E);
+      return offset;
+    }
+
+  #endif // ABL_BICUBIC_INTERPOLATION
+
+  #if !IS_KINEMATIC
 
-      // Do the split and look for more borders
-      bilinear_line_to_destination(fr_mm_s, x_splits, y_splits);
+    /**
+     * Prepare a bilinear-leveled linear move on Cartesian,
+     * splitting the move where it crosses mesh borders.
+     * The bicubic patches are curved inside the cell, so the move
+     * is split at ABL_BICUBIC_SEGMENTS sub-cell lines as well.
+     */
+    #if ENABLED(ABL_BICUBIC_INTERPOLATION)
+      #define ABL_BG_SPLIT  (ABL_BICUBIC_SEGMENTS)
+    #else
+      #define ABL_BG_SPLIT  1
+    #endif
 
-      // Restore destination from stack
-      COPY_ARRAY(mechanics.destination, end);
-      bilinear_line_to_destination(fr_mm_s, x_splits, y_splits);
+    void AutoBedLevel::bilinear_line_to_destination(const float fr_mm_s) {
+      const mesh_grid_t grid = {
+        (float)bilinear_start[X_AXIS], (float)bilinear_start[Y_AXIS],
+        (float)ABL_BG_SPACING(X_AXIS) / (ABL_BG_SPLIT), (float)ABL_BG_SPACING(Y_AXIS) / (ABL_BG_SPLIT),
+        ABL_BG_FACTOR(X_AXIS) * (ABL_BG_SPLIT), ABL_BG_FACTOR(Y_AXIS) * (ABL_BG_SPLIT),
+        (ABL_BG_POINTS_X - 1) * (ABL_BG_SPLIT), (ABL_BG_POINTS_Y - 1) * (ABL_BG_SPLIT)
+      };
+      bedlevel.mesh_line_to_destination(grid, fr_mm_s, tools.active_extruder);
     }
 
   #endif // !IS_KINEMATIC
@@ -37,19 +37,32 @@
                     bilinear_start[2];
       static float  z_values[GRID_MAX_POINTS_X][GRID_MAX_POINTS_Y];
 
+      #if ENABLED(ABL_PRINT_AREA_PROBING)
+        // Print area of the next G29, set by M555
+        static bool   print_area_set;
+        static float  print_area_min[2],
+                      print_area_max[2];
+      #endif
+
     private: /** Private Parameters */
 
       static float  bilinear_grid_factor[2];
 
+      #if ENABLED(ABL_BILINEAR_SUBDIVISION) || ENABLED(ABL_BICUBIC_INTERPOLATION)
+        #define ABL_TEMP_POINTS_X (GRID_MAX_POINTS_X + 2)
+        #define ABL_TEMP_POINTS_Y (GRID_MAX_POINTS_Y + 2)
+      #endif
+
       #if ENABLED(ABL_BILINEAR_SUBDIVISION)
         #define ABL_GRID_POINTS_VIRT_X (GRID_MAX_POINTS_X - 1) * (BILINEAR_SUBDIVISIONS) + 1
         #define ABL_GRID_POINTS_VIRT_Y (GRID_MAX_POINTS_Y - 1) * (BILINEAR_SUBDIVISIONS) + 1
-        #define ABL_TEMP_POINTS_X (GRID_MAX_POINTS_X + 2)
-        #define ABL_TEMP_POINTS_Y (GRID_MAX_POINTS_Y + 2)
 
         static float  bilinear_grid_factor_virt[2],
                       z_values_virt[ABL_GRID_POINTS_VIRT_X][ABL_GRID_POINTS_VIRT_Y];
         static int    bilinear_grid_spacing_virt[2];
+      #elif ENABLED(ABL_BICUBIC_INTERPOLATION)
+        // Polynomial of each grid cell: z = sum of [i][j] * u^i * v^j, with u and v from 0 to 1 in the cell
+        static float  bicubic_coeff[GRID_MAX_POINTS_X - 1][GRID_MAX_POINTS_Y - 1][4][4];
       #endif
 
     public: /** Public Function */
@@ -68,10 +81,12 @@
       #if ENABLED(ABL_BILINEAR_SUBDIVISION)
         static void print_bilinear_leveling_grid_virt();
         static void virt_interpolate();
+      #elif ENABLED(ABL_BICUBIC_INTERPOLATION)
+        static void bicubic_interpolate();
       #endif
 
       #if !IS_KINEMATIC
-        void bilinear_line_to_destination(float fr_mm_s, uint16_t x_splits=0xFFFF, uint16_t y_splits=0xFFFF);
+        void bilinear_line_to_destination(const float fr_mm_s);
       #endif
 
     private: /** Private Function */
@@ -81,10 +96,14 @@
        */
       static void extrapolate_one_point(const uint8_t x, const uint8_t y, const int8_t xdir, const int8_t ydir);
 
-      #if ENABLED(ABL_BILINEAR_SUBDIVISION)
+      #if ENABLED(ABL_BILINEAR_SUBDIVISION) || ENABLED(ABL_BICUBIC_INTERPOLATION)
         static float bed_level_virt_coord(const uint8_t x, const uint8_t y);
+      #endif
+      #if ENABLED(ABL_BILINEAR_SUBDIVISION)
         static float bed_level_virt_cmr(const float p[4], const uint8_t i, const float t);
         static float bed_level_virt_2cmr(const uint8_t x, const uint8_t y, const float &tx, const float &ty);
+      #elif ENABLED(ABL_BICUBIC_INTERPOLATION)
+        static void bicubic_cmr_coeff(const float p[4], float a[4]);
       #endif
 
   };
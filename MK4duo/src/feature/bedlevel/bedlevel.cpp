@@ -329,6 +329,89 @@
     }
   #endif
 
+  #if HAS_MESH
+
+    void Bedlevel::buffer_mesh_segment(const float (&pos)[XYZE], const int8_t cx, const int8_t cy, const float &fr_mm_s, const uint8_t extruder) {
+      UNUSED(cx);
+      UNUSED(cy);
+      planner.buffer_line(pos[X_AXIS], pos[Y_AXIS], pos[Z_AXIS], pos[E_AXIS], fr_mm_s, extruder);
+    }
+
+    /**
+     * Move from current_position to destination, splitting the move
+     * where it crosses the mesh lines, without recursion or copies of
+     * destination.
+     *
+     * The crossed cells are walked in order, like a DDA over the cell
+     * borders: the fraction of the move at the next X and at the next
+     * Y border is advanced by a constant step at each crossing and the
+     * nearest one ends the piece. A corner crosses both borders in one
+     * piece. segment() gets each piece, then current_position is set
+     * to destination.
+     */
+    void Bedlevel::mesh_line_to_destination(const mesh_grid_t &grid, const float &fr_mm_s, const uint8_t extruder, mesh_segment_func_t segment/*=buffer_mesh_segment*/) {
+
+      const float * const start = mechanics.current_position,
+                  * const end   = mechanics.destination;
+
+      int cx = (start[X_AXIS] - grid.origin_x) * grid.factor_x,
+          cy = (start[Y_AXIS] - grid.origin_y) * grid.factor_y,
+          ex = (end[X_AXIS]   - grid.origin_x) * grid.factor_x,
+          ey = (end[Y_AXIS]   - grid.origin_y) * grid.factor_y;
+
+      cx = constrain(cx, 0, grid.cells_x - 1);
+      cy = constrain(cy, 0, grid.cells_y - 1);
+      ex = constrain(ex, 0, grid.cells_x - 1);
+      ey = constrain(ey, 0, grid.cells_y - 1);
+
+      if (cx != ex || cy != ey) {
+
+        const int8_t  sx = ex > cx ? 1 : -1,
+                      sy = ey > cy ? 1 : -1;
+
+        // Fraction of the move at the next border, 2 when no border is left
+        float tx = 2.0, ty = 2.0, step_x = 0.0, step_y = 0.0, pos[XYZE];
+
+        if (cx != ex) {
+          const float dx = end[X_AXIS] - start[X_AXIS];
+          tx = (grid.origin_x + (cx + (sx > 0)) * grid.spacing_x - start[X_AXIS]) / dx;
+          step_x = grid.spacing_x / FABS(dx);
+        }
+        if (cy != ey) {
+          const float dy = end[Y_AXIS] - start[Y_AXIS];
+          ty = (grid.origin_y + (cy + (sy > 0)) * grid.spacing_y - start[Y_AXIS]) / dy;
+          step_y = grid.spacing_y / FABS(dy);
+        }
+
+        while (cx != ex || cy != ey) {
+          const float t = min(tx, ty);
+          const int8_t pcx = cx, pcy = cy;
+
+          LOOP_XYZE(i) pos[i] = start[i] + (end[i] - start[i]) * t;
+
+          if (tx <= t) {
+            // Land exactly on the X border
+            pos[X_AXIS] = grid.origin_x + (cx + (sx > 0)) * grid.spacing_x;
+            cx += sx;
+            tx = cx != ex ? tx + step_x : 2.0;
+          }
+          if (ty <= t) {
+            pos[Y_AXIS] = grid.origin_y + (cy + (sy > 0)) * grid.spacing_y;
+            cy += sy;
+            ty = cy != ey ? ty + step_y : 2.0;
+          }
+
+          // A move starting on a border has nothing to do before it
+          if (t > 0.0) segment(pos, pcx, pcy, fr_mm_s, extruder);
+        }
+      }
+
+      segment(mechanics.destination, ex, ey, fr_mm_s, extruder);
+      mechanics.set_current_to_destination();
+    }
+
+  #endif // HAS_MESH
+
   #if ENABLED(AUTO_BED_LEVELING_BILINEAR) || ENABLED(MESH_BED_LEVELING)
 
     /**
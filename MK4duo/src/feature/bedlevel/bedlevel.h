@@ -51,6 +51,28 @@
     #include "ubl/ubl.h"
   #endif
 
+  #if HAS_MESH
+
+    /**
+     * Mesh geometry for mesh_line_to_destination.
+     * The cells are numbered from 0 to cells - 1; positions outside
+     * the mesh belong to the first or last cell.
+     */
+    typedef struct {
+      float   origin_x,  origin_y,    // Position of the first mesh line
+              spacing_x, spacing_y,   // Distance between mesh lines
+              factor_x,  factor_y;    // 1.0 / spacing
+      int8_t  cells_x,   cells_y;
+    } mesh_grid_t;
+
+    /**
+     * Called for each piece of a mesh move with the end of the piece
+     * and the mesh cell the piece lies in.
+     */
+    typedef void (*mesh_segment_func_t)(const float (&pos)[XYZE], const int8_t cx, const int8_t cy, const float &fr_mm_s, const uint8_t extruder);
+
+  #endif
+
   class Bedlevel {
 
     public: /** Constructor */
@@ -146,6 +168,20 @@
 
       #endif
 
+      #if HAS_MESH
+
+        /**
+         * Buffer a piece of a mesh move, leveled by the planner.
+         */
+        static void buffer_mesh_segment(const float (&pos)[XYZE], const int8_t cx, const int8_t cy, const float &fr_mm_s, const uint8_t extruder);
+
+        /**
+         * Move to destination splitting the move where it crosses the mesh lines.
+         */
+        static void mesh_line_to_destination(const mesh_grid_t &grid, const float &fr_mm_s, const uint8_t extruder, mesh_segment_func_t segment=buffer_mesh_segment);
+
+      #endif
+
       #if ENABLED(AUTO_BED_LEVELING_BILINEAR) || ENABLED(MESH_BED_LEVELING)
 
         /**
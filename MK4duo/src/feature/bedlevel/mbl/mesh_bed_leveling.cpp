@@ -53,59 +53,14 @@
    * Prepare a mesh-leveled linear move in a Cartesian setup,
    * splitting the move where it crosses mesh borders.
    */
-  void mesh_bed_leveling::line_to_destination(float fr_mm_s, uint8_t x_splits/*= 0xFF*/, uint8_t y_splits/*= 0xFF*/) {
-    int cx1 = mbl.cell_index_x(mechanics.current_position[X_AXIS]),
-        cy1 = mbl.cell_index_y(mechanics.current_position[Y_AXIS]),
-        cx2 = mbl.cell_index_x(mechanics.destination[X_AXIS]),
-        cy2 = mbl.cell_index_y(mechanics.destination[Y_AXIS]);
-    NOMORE(cx1, GRID_MAX_POINTS_X - 2);
-    NOMORE(cy1, GRID_MAX_POINTS_Y - 2);
-    NOMORE(cx2, GRID_MAX_POINTS_X - 2);
-    NOMORE(cy2, GRID_MAX_POINTS_Y - 2);
-
-    if (cx1 == cx2 && cy1 == cy2) {
-      // Start and end on same mesh square
-      mechanics.line_to_destination(fr_mm_s);
-      mechanics.set_current_to_destination();
-      return;
-    }
-
-    #define MBL_SEGMENT_END(A) (mechanics.current_position[A ##_AXIS] + (mechanics.destination[A ##_AXIS] - mechanics.current_position[A ##_AXIS]) * normalized_dist)
-
-    float normalized_dist, end[XYZE];
-
-    // Split at the left/front border of the right/top square
-    const int8_t gcx = max(cx1, cx2), gcy = max(cy1, cy2);
-    if (cx2 != cx1 && TEST(x_splits, gcx)) {
-      COPY_ARRAY(end, mechanics.destination);
-      mechanics.destination[X_AXIS] = index_to_xpos[gcx];
-      normalized_dist = (mechanics.destination[X_AXIS] - mechanics.current_position[X_AXIS]) / (end[X_AXIS] - mechanics.current_position[X_AXIS]);
-      mechanics.destination[Y_AXIS] = MBL_SEGMENT_END(Y);
-      CBI(x_splits, gcx);
-    }
-    else if (cy2 != cy1 && TEST(y_splits, gcy)) {
-      COPY_ARRAY(end, mechanics.destination);
-      mechanics.destination[Y_AXIS] = index_to_ypos[gcy];
-      normalized_dist = (mechanics.destination[Y_AXIS] - mechanics.current_position[Y_AXIS]) / (end[Y_AXIS] - mechanics.current_position[Y_AXIS]);
-      mechanics.destination[X_AXIS] = MBL_SEGMENT_END(X);
-      CBI(y_splits, gcy);
-    }
-    else {
-      // Already split on a border
-      mechanics.line_to_destination(fr_mm_s);
-      mechanics.set_current_to_destination();
-      return;
-    }
-
-    mechanics.destination[Z_AXIS] = MBL_SEGMENT_END(Z);
-    mechanics.destination[E_AXIS] = MBL_SEGMENT_END(E);
-
-    // Do the split and look for more borders
-    line_to_destination(fr_mm_s, x_splits, y_splits);
-
-    // Restore destination from stack
-    COPY_ARRAY(mechanics.destination, end);
-    line_to_destination(fr_mm_s, x_splits, y_splits);  
+  void mesh_bed_leveling::line_to_destination(const float fr_mm_s) {
+    static const mesh_grid_t grid = {
+      MESH_MIN_X, MESH_MIN_Y,
+      MESH_X_DIST, MESH_Y_DIST,
+      1.0 / (MESH_X_DIST), 1.0 / (MESH_Y_DIST),
+      GRID_MAX_POINTS_X - 1, GRID_MAX_POINTS_Y - 1
+    };
+    bedlevel.mesh_line_to_destination(grid, fr_mm_s, tools.active_extruder);
   }
 
   void mesh_bed_leveling::probing_done() {
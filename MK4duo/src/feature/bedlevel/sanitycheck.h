@@ -69,6 +69,13 @@ static_assert(1 >= 0
   #if ENABLED(ENABLE_MESH_EDIT_GFX_OVERLAY) && !ENABLED(DOGLCD)
     #error "ENABLE_MESH_EDIT_GFX_OVERLAY requires a DOGLCD."
   #endif
+  #if ENABLED(UBL_ENCODED_MESHES)
+    #if DISABLED(UBL_MESH_SLOT_SIZE)
+      #error "UBL_ENCODED_MESHES requires UBL_MESH_SLOT_SIZE."
+    #elif UBL_MESH_SLOT_SIZE != 0 && UBL_MESH_SLOT_SIZE < 7 + GRID_MAX_POINTS_X * GRID_MAX_POINTS_Y
+      #error "UBL_MESH_SLOT_SIZE must be 0 or at least 7 + 1 byte per mesh point."
+    #endif
+  #endif
 #endif
 
 /**
@@ -84,6 +91,47 @@ static_assert(1 >= 0
   #endif
 #endif
 
+/**
+ * Bicubic interpolation of the bilinear grid
+ */
+#if ENABLED(ABL_BICUBIC_INTERPOLATION)
+  #if DISABLED(AUTO_BED_LEVELING_BILINEAR)
+    #error "ABL_BICUBIC_INTERPOLATION requires AUTO_BED_LEVELING_BILINEAR."
+  #elif ENABLED(ABL_BILINEAR_SUBDIVISION)
+    #error "ABL_BICUBIC_INTERPOLATION and ABL_BILINEAR_SUBDIVISION are incompatible. Please enable only one."
+  #elif !IS_KINEMATIC && DISABLED(ABL_BICUBIC_SEGMENTS)
+    #error "ABL_BICUBIC_INTERPOLATION requires ABL_BICUBIC_SEGMENTS."
+  #elif !IS_KINEMATIC && (ABL_BICUBIC_SEGMENTS < 1 || (GRID_MAX_POINTS_X - 1) * (ABL_BICUBIC_SEGMENTS) > 127 || (GRID_MAX_POINTS_Y - 1) * (ABL_BICUBIC_SEGMENTS) > 127)
+    #error "ABL_BICUBIC_SEGMENTS must be 1 or more, with no more than 127 segments along the grid."
+  #endif
+#endif
+
+/**
+ * Adaptive probing of the bilinear grid
+ */
+#if ENABLED(ABL_ADAPTIVE_PROBING)
+  #if DISABLED(AUTO_BED_LEVELING_BILINEAR)
+    #error "ABL_ADAPTIVE_PROBING requires AUTO_BED_LEVELING_BILINEAR."
+  #elif ENABLED(PROBE_MANUALLY)
+    #error "ABL_ADAPTIVE_PROBING is incompatible with PROBE_MANUALLY."
+  #elif DISABLED(ABL_ADAPTIVE_TOLERANCE)
+    #error "ABL_ADAPTIVE_PROBING requires ABL_ADAPTIVE_TOLERANCE."
+  #endif
+#endif
+
+/**
+ * Probing of the print area only
+ */
+#if ENABLED(ABL_PRINT_AREA_PROBING)
+  #if DISABLED(AUTO_BED_LEVELING_BILINEAR)
+    #error "ABL_PRINT_AREA_PROBING requires AUTO_BED_LEVELING_BILINEAR."
+  #elif ENABLED(PROBE_MANUALLY)
+    #error "ABL_PRINT_AREA_PROBING is incompatible with PROBE_MANUALLY."
+  #elif DISABLED(ABL_PRINT_AREA_MARGIN)
+    #error "ABL_PRINT_AREA_PROBING requires ABL_PRINT_AREA_MARGIN."
+  #endif
+#endif
+
 /**
  * ENABLE_LEVELING_FADE_HEIGHT requirements
  */
@@ -364,6 +364,7 @@ class unified_bed_leveling {
 
     static bool prepare_segmented_line_to(const float rtarget[XYZE], const float &feedrate);
     static void line_to_destination_cartesian(const float &fr, uint8_t e);
+    static void buffer_mesh_segment(const float (&pos)[XYZE], const int8_t cx, const int8_t cy, const float &fr_mm_s, const uint8_t extruder);
 
     #define _CMPZ(a,b) (z_values[a][b] == z_values[a][b+1])
     #define CMPZ(a) (_CMPZ(a, 0) && _CMPZ(a, 1))
@@ -1244,6 +1244,8 @@
     SERIAL_EOL();
     SERIAL_EMV("z_value[][] size: ", (int)sizeof(z_values));
     SERIAL_EOL();
+    SERIAL_EMV("Mesh slot size: ", eeprom.get_mesh_slot_size());
+    SERIAL_EOL();
     printer.safe_delay(25);
 
     SERIAL_EMV("EEPROM free for UBL: ", hex_address((void*)(eeprom.get_end_of_meshes() - eeprom.get_start_of_meshes())));
@@ -0,0 +1,104 @@
+/**
+ * MK4duo Firmware for 3D Printer, Laser and CNC
+ *
+ * Based on Marlin, Sprinter and grbl
+ * Copyright (C) 2011 Camiel Gubbels / Erik van der Zalm
+ * Copyright (C) 2013 Alberto Cotronei @MagoKimbra
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "../../../MK4duo.h"
+
+#if ENABLED(CYCLE_PROFILER)
+
+  CycleProfiler cycleprofiler;
+
+  cycle_stats_t CycleProfiler::stats[CYCLE_PROBE_COUNT];
+  millis_t      CycleProfiler::start_ms = 0;
+
+  void CycleProfiler::init() {
+    #if ENABLED(ARDUINO_ARCH_SAM)
+      // Enable the DWT cycle counter
+      CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+      DWT->CYCCNT = 0;
+      DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+    #endif
+    reset();
+  }
+
+  void CycleProfiler::reset() {
+    CRITICAL_SECTION_START
+      for (uint8_t p = 0; p < CYCLE_PROBE_COUNT; p++) {
+        stats[p].count = 0;
+        stats[p].total = 0;
+        stats[p].min = 0xFFFFFFFF;
+        stats[p].max = 0;
+      }
+    CRITICAL_SECTION_END
+    start_ms = millis();
+  }
+
+  void CycleProfiler::add(const CycleProbeEnum probe, const cycle_t cycles) {
+    cycle_stats_t &s = stats[probe];
+    CRITICAL_SECTION_START
+      s.count++;
+      s.total += cycles;
+      if (cycles < s.min) s.min = cycles;
+      if (cycles > s.max) s.max = cycles;
+    CRITICAL_SECTION_END
+  }
+
+  void CycleProfiler::report() {
+    const millis_t elapsed = millis() - start_ms;
+
+    SERIAL_SMV(ECHO, "Cycle profile over ", (uint32_t)elapsed);
+    SERIAL_EM(" ms");
+    print_probe(PSTR("Stepper ISR"),  PROBE_STEPPER_ISR,  elapsed);
+    #if ENABLED(LIN_ADVANCE)
+      print_probe(PSTR("Advance ISR"),  PROBE_ADVANCE_ISR,  elapsed);
+    #endif
+    print_probe(PSTR("Step prep"),    PROBE_STEP_PREP,    elapsed);
+    print_probe(PSTR("Tick"),         PROBE_TICK,         elapsed);
+    print_probe(PSTR("Idle"),         PROBE_IDLE,         elapsed);
+    print_probe(PSTR("Temp spin"),    PROBE_TEMP_SPIN,    elapsed);
+    print_probe(PSTR("Buffer line"),  PROBE_BUFFER_LINE,  elapsed);
+    #if IS_DELTA
+      print_probe(PSTR("Delta kinematics"), PROBE_DELTA_KINEMATICS, elapsed);
+    #endif
+  }
+
+  void CycleProfiler::print_probe(const char * const label, const CycleProbeEnum probe, const millis_t elapsed) {
+    CRITICAL_SECTION_START
+      const cycle_stats_t s = stats[probe];
+    CRITICAL_SECTION_END
+
+    SERIAL_SM(ECHO, "  ");
+    SERIAL_PS(label);
+    SERIAL_MV(": n=", s.count);
+    if (s.count) {
+      SERIAL_MV(" min=", s.min);
+      SERIAL_MV(" avg=", (uint32_t)(s.total / s.count));
+      SERIAL_MV(" max=", s.max);
+      // Share of all the CPU cycles since the last reset
+      if (elapsed) {
+        SERIAL_MV(" load=", (float)s.total * 100.0f / ((float)elapsed * (float)(F_CPU / 1000UL)), 2);
+        SERIAL_CHR('%');
+      }
+    }
+    SERIAL_EOL();
+  }
+
+#endif // ENABLED(CYCLE_PROFILER)
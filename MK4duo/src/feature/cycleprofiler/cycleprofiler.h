@@ -0,0 +1,138 @@
+/**
+ * MK4duo Firmware for 3D Printer, Laser and CNC
+ *
+ * Based on Marlin, Sprinter and grbl
+ * Copyright (C) 2011 Camiel Gubbels / Erik van der Zalm
+ * Copyright (C) 2013 Alberto Cotronei @MagoKimbra
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+/**
+ * cycleprofiler.h - CPU cycle profiler for the ISRs and the main loop
+ *
+ * Measures min, average and max CPU cycles spent in each probed function
+ * and its share of the whole CPU time since the last reset.
+ *
+ * Cycle source:
+ *   SAM - DWT cycle counter, one cycle resolution
+ *   AVR - micros(), 4us (64 cycles) resolution
+ *
+ * Times are inclusive: nested probes and the interrupts served meanwhile
+ * are counted in the enclosing probe too.
+ */
+
+#ifndef _CYCLEPROFILER_H_
+#define _CYCLEPROFILER_H_
+
+#if ENABLED(CYCLE_PROFILER)
+
+  enum CycleProbeEnum : uint8_t {
+    PROBE_STEPPER_ISR,        // Stepper::isr or Stepper::ring_isr
+    PROBE_ADVANCE_ISR,        // Stepper::advance_isr
+    PROBE_STEP_PREP,          // Stepper::prepare_segments or Stepper::fill_step_ring
+    PROBE_TICK,               // HAL::Tick on SAM, the temperature ISR on AVR
+    PROBE_IDLE,               // Printer::idle
+    PROBE_TEMP_SPIN,          // Temperature::spin
+    PROBE_BUFFER_LINE,        // Planner::_buffer_line
+    PROBE_DELTA_KINEMATICS,   // Delta segment transform, per batch or segment
+    CYCLE_PROBE_COUNT
+  };
+
+  typedef uint32_t cycle_t;
+
+  typedef struct {
+    uint32_t  count;
+    uint64_t  total;
+    cycle_t   min,
+              max;
+  } cycle_stats_t;
+
+  class CycleProfiler {
+
+    public: /** Constructor */
+
+      CycleProfiler() {};
+
+    public: /** Public Parameters */
+
+      static cycle_stats_t stats[CYCLE_PROBE_COUNT];
+
+    public: /** Public Function */
+
+      static void init();
+      static void reset();
+      static void report();
+
+      FORCE_INLINE static cycle_t now() {
+        #if ENABLED(ARDUINO_ARCH_SAM)
+          return DWT->CYCCNT;
+        #else
+          return (cycle_t)micros() * (F_CPU / 1000000UL);
+        #endif
+      }
+
+      static void add(const CycleProbeEnum probe, const cycle_t cycles);
+
+    private: /** Private Parameters */
+
+      static millis_t start_ms;
+
+    private: /** Private Function */
+
+      static void print_probe(const char * const label, const CycleProbeEnum probe, const millis_t elapsed);
+
+  };
+
+  extern CycleProfiler cycleprofiler;
+
+  /**
+   * Scoped probe: counts the cycles from its construction to the end of
+   * the enclosing block, so every return path of the function is covered.
+   * pause() / resume() leave out a part of the block, like a blocking wait.
+   */
+  class CycleProbe {
+
+    public: /** Constructor */
+
+      CycleProbe(const CycleProbeEnum p) : probe(p), start(CycleProfiler::now()) {}
+
+      ~CycleProbe() { CycleProfiler::add(probe, CycleProfiler::now() - start); }
+
+    public: /** Public Function */
+
+      FORCE_INLINE void pause()  { paused = CycleProfiler::now(); }
+      FORCE_INLINE void resume() { start += CycleProfiler::now() - paused; }
+
+    private: /** Private Parameters */
+
+      const CycleProbeEnum probe;
+      cycle_t start, paused;
+
+  };
+
+  #define CYCLE_PROBE(P)        CycleProbe _cycle_probe_##P(PROBE_##P)
+  #define CYCLE_PROBE_PAUSE(P)  _cycle_probe_##P.pause()
+  #define CYCLE_PROBE_RESUME(P) _cycle_probe_##P.resume()
+
+#else
+
+  #define CYCLE_PROBE(P)        NOOP
+  #define CYCLE_PROBE_PAUSE(P)  NOOP
+  #define CYCLE_PROBE_RESUME(P) NOOP
+
+#endif // ENABLED(CYCLE_PROFILER)
+
+#endif /* _CYCLEPROFILER_H_ */
@@ -0,0 +1,64 @@
+/**
+ * MK4duo Firmware for 3D Printer, Laser and CNC
+ *
+ * Based on Marlin, Sprinter and grbl
+ * Copyright (C) 2011 Camiel Gubbels / Erik van der Zalm
+ * Copyright (C) 2013 Alberto Cotronei @MagoKimbra
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "../../../MK4duo.h"
+
+#if ENABLED(MOTION_STATS)
+
+  MotionStats motionstats;
+
+  uint32_t          MotionStats::lines    = 0,
+                    MotionStats::blocks   = 0;
+  volatile uint32_t MotionStats::steps    = 0;
+  millis_t          MotionStats::start_ms = 0;
+
+  void MotionStats::reset() {
+    CRITICAL_SECTION_START
+      lines = blocks = steps = 0;
+    CRITICAL_SECTION_END
+    start_ms = millis();
+  }
+
+  void MotionStats::report() {
+    CRITICAL_SECTION_START
+      const uint32_t step_count = steps;
+    CRITICAL_SECTION_END
+
+    const millis_t elapsed = millis() - start_ms;
+
+    SERIAL_SMV(ECHO, "Motion stats over ", (uint32_t)elapsed);
+    SERIAL_EM(" ms");
+    print_rate(PSTR("Lines"),  lines,       elapsed);
+    print_rate(PSTR("Blocks"), blocks,      elapsed);
+    print_rate(PSTR("Steps"),  step_count,  elapsed);
+  }
+
+  void MotionStats::print_rate(const char * const label, const uint32_t count, const millis_t elapsed) {
+    SERIAL_SM(ECHO, "  ");
+    SERIAL_PS(label);
+    SERIAL_MV(": ", count);
+    if (elapsed) SERIAL_MV(" (", (float)count * 1000.0f / (float)elapsed, 1);
+    else SERIAL_MSG(" (0");
+    SERIAL_EM("/s)");
+  }
+
+#endif // ENABLED(MOTION_STATS)
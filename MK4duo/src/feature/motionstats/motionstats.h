@@ -0,0 +1,76 @@
+/**
+ * MK4duo Firmware for 3D Printer, Laser and CNC
+ *
+ * Based on Marlin, Sprinter and grbl
+ * Copyright (C) 2011 Camiel Gubbels / Erik van der Zalm
+ * Copyright (C) 2013 Alberto Cotronei @MagoKimbra
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+/**
+ * motionstats.h - Throughput counters for the motion pipeline
+ *
+ * Counts what flows through Commands -> Planner -> Stepper so the
+ * cost of the whole chain can be measured on the real board:
+ *   lines   - G-code lines executed by process_next_command
+ *   blocks  - Blocks queued by Planner::_buffer_line
+ *   steps   - Step events completed by the Stepper ISR
+ */
+
+#ifndef _MOTIONSTATS_H_
+#define _MOTIONSTATS_H_
+
+#if ENABLED(MOTION_STATS)
+
+  class MotionStats {
+
+    public: /** Constructor */
+
+      MotionStats() {};
+
+    public: /** Public Parameters */
+
+      static uint32_t lines,
+                      blocks;
+
+      static volatile uint32_t steps;
+
+    public: /** Public Function */
+
+      static void reset();
+      static void report();
+
+      FORCE_INLINE static void line_executed()  { lines++; }
+      FORCE_INLINE static void block_queued()   { blocks++; }
+
+      // Called from the Stepper ISR once per finished block
+      FORCE_INLINE static void block_done(const uint32_t step_events) { steps += step_events; }
+
+    private: /** Private Parameters */
+
+      static millis_t start_ms;
+
+    private: /** Private Function */
+
+      static void print_rate(const char * const label, const uint32_t count, const millis_t elapsed);
+
+  };
+
+  extern MotionStats motionstats;
+
+#endif // ENABLED(MOTION_STATS)
+
+#endif /* _MOTIONSTATS_H_ */
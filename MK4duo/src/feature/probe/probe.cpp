@@ -389,6 +389,8 @@ void Probe::refresh_zoffset(const bool no_babystep/*=false*/) {
       }
       #if ENABLED(ABL_BILINEAR_SUBDIVISION)
         abl.virt_interpolate();
+      #elif ENABLED(ABL_BICUBIC_INTERPOLATION)
+        abl.bicubic_interpolate();
       #endif
     #endif
 
@@ -0,0 +1,189 @@
+/**
+ * MK4duo Firmware for 3D Printer, Laser and CNC
+ *
+ * Based on Marlin, Sprinter and grbl
+ * Copyright (C) 2011 Camiel Gubbels / Erik van der Zalm
+ * Copyright (C) 2013 Alberto Cotronei @MagoKimbra
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "../../../MK4duo.h"
+
+#if ENABLED(TEMP_TELEMETRY)
+
+  Telemetry telemetry;
+
+  bool                Telemetry::recording  = true;
+  uint8_t             Telemetry::interval   = 1;
+  telemetry_sample_t  Telemetry::samples[TEMP_TELEMETRY_SAMPLES];
+  uint16_t            Telemetry::head       = 0,
+                      Telemetry::count      = 0;
+  uint8_t             Telemetry::spins      = 0;
+
+  void Telemetry::reset() {
+    head = count = 0;
+    spins = 0;
+  }
+
+  /**
+   * Called at the end of each temperature spin
+   */
+  void Telemetry::sample() {
+
+    if (!recording || ++spins < interval) return;
+    spins = 0;
+
+    telemetry_sample_t &s = samples[head];
+
+    s.ms = millis();
+    LOOP_HEATER() {
+      s.temp[h]   = LROUND(heaters[h].current_temperature * 10.0);
+      s.target[h] = heaters[h].target_temperature;
+      s.output[h] = heaters[h].soft_pwm;
+    }
+    #if FAN_COUNT > 0
+      LOOP_FAN() s.fan[f] = fans[f].Speed;
+    #endif
+
+    if (++head == TEMP_TELEMETRY_SAMPLES) head = 0;
+    if (count < TEMP_TELEMETRY_SAMPLES) count++;
+  }
+
+  void Telemetry::report_state() {
+    SERIAL_SMT(ECHO, "Telemetry ", recording ? "recording" : "stopped");
+    SERIAL_MV(" samples:", count);
+    SERIAL_MV("/", TEMP_TELEMETRY_SAMPLES);
+    SERIAL_MV(" interval:", interval * 100);
+    SERIAL_EM("ms");
+  }
+
+  /**
+   * CSV, one line per sample from the oldest. Time in ms from the first sample,
+   * then temperature, target and output of each heater, then the fan speeds.
+   */
+  void Telemetry::dump_csv() {
+    char line[16 + 20 * (HEATER_COUNT) + 4 * (FAN_COUNT)];
+    uint32_t ms = 0;
+
+    SERIAL_EM("Begin telemetry");
+    csv_header(line);
+    SERIAL_ET(line);
+    for (uint16_t i = 0; i < count; i++) {
+      const telemetry_sample_t * const s = get_sample(i);
+      if (i) ms += (uint16_t)(s->ms - get_sample(i - 1)->ms);
+      csv_line(line, s, ms);
+      SERIAL_ET(line);
+    }
+    SERIAL_EM("End telemetry");
+  }
+
+  /**
+   * Header line with the record count and size, then the raw records
+   */
+  void Telemetry::dump_binary() {
+    SERIAL_MV("Begin telemetry binary ", count);
+    SERIAL_EMV(" ", TELEMETRY_RECORD_SIZE);
+    for (uint16_t i = 0; i < count; i++) {
+      const telemetry_sample_t * const s = get_sample(i);
+      SERIAL_CHR((char)(s->ms & 0xFF));
+      SERIAL_CHR((char)(s->ms >> 8));
+      LOOP_HEATER() {
+        SERIAL_CHR((char)(s->temp[h] & 0xFF));
+        SERIAL_CHR((char)(s->temp[h] >> 8));
+      }
+      LOOP_HEATER() {
+        SERIAL_CHR((char)(s->target[h] & 0xFF));
+        SERIAL_CHR((char)(s->target[h] >> 8));
+      }
+      LOOP_HEATER() SERIAL_CHR((char)s->output[h]);
+      #if FAN_COUNT > 0
+        LOOP_FAN() SERIAL_CHR((char)s->fan[f]);
+      #endif
+    }
+    SERIAL_EOL();
+    SERIAL_EM("End telemetry");
+  }
+
+  #if HAS_SDSUPPORT
+
+    void Telemetry::dump_sd() {
+      char line[16 + 20 * (HEATER_COUNT) + 4 * (FAN_COUNT)];
+      uint32_t ms = 0;
+      SdFile file;
+
+      if (!card.cardOK) {
+        SERIAL_LM(ER, "SD card not ready");
+        return;
+      }
+
+      if (!file.open(card.curDir, TEMP_TELEMETRY_FILE, O_CREAT | O_WRITE | O_TRUNC)) {
+        SERIAL_LMT(ER, MSG_SD_OPEN_FILE_FAIL, TEMP_TELEMETRY_FILE);
+        return;
+      }
+
+      SERIAL_EMT(MSG_SD_WRITE_TO_FILE, TEMP_TELEMETRY_FILE);
+
+      file.writeError = false;
+      csv_header(line);
+      file.write(line);
+      file.write("\r\n");
+      for (uint16_t i = 0; i < count && !file.writeError; i++) {
+        const telemetry_sample_t * const s = get_sample(i);
+        if (i) ms += (uint16_t)(s->ms - get_sample(i - 1)->ms);
+        csv_line(line, s, ms);
+        file.write(line);
+        file.write("\r\n");
+      }
+
+      if (file.writeError)
+        SERIAL_LM(ER, MSG_SD_ERR_WRITE_TO_FILE);
+      else
+        SERIAL_EM(MSG_SD_FILE_SAVED);
+
+      file.sync();
+      file.close();
+    }
+
+  #endif // HAS_SDSUPPORT
+
+  // Private function
+
+  const telemetry_sample_t* Telemetry::get_sample(const uint16_t i) {
+    uint16_t index = head + TEMP_TELEMETRY_SAMPLES - count + i;
+    if (index >= TEMP_TELEMETRY_SAMPLES) index -= TEMP_TELEMETRY_SAMPLES;
+    return &samples[index];
+  }
+
+  void Telemetry::csv_header(char *line) {
+    char *p = line + sprintf_P(line, PSTR("ms"));
+    LOOP_HEATER() p += sprintf_P(p, PSTR(",T%i,S%i,P%i"), h, h, h);
+    #if FAN_COUNT > 0
+      LOOP_FAN() p += sprintf_P(p, PSTR(",F%i"), f);
+    #endif
+  }
+
+  void Telemetry::csv_line(char *line, const telemetry_sample_t * const s, const uint32_t ms) {
+    char *p = line + sprintf_P(line, PSTR("%lu"), (unsigned long)ms);
+    LOOP_HEATER() {
+      const int16_t t = s->temp[h];
+      p += sprintf_P(p, PSTR(",%s%i.%i,%i,%i"), t < 0 ? "-" : "", abs(t) / 10, abs(t) % 10, s->target[h], s->output[h]);
+    }
+    #if FAN_COUNT > 0
+      LOOP_FAN() p += sprintf_P(p, PSTR(",%i"), s->fan[f]);
+    #endif
+  }
+
+#endif // ENABLED(TEMP_TELEMETRY)
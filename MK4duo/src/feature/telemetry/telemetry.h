@@ -0,0 +1,98 @@
+/**
+ * MK4duo Firmware for 3D Printer, Laser and CNC
+ *
+ * Based on Marlin, Sprinter and grbl
+ * Copyright (C) 2011 Camiel Gubbels / Erik van der Zalm
+ * Copyright (C) 2013 Alberto Cotronei @MagoKimbra
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+/**
+ * telemetry.h - Heater telemetry ring buffer
+ *
+ * Records temperature, target and output of every heater and the fan
+ * duties at each temperature spin (100ms), or every n spins, keeping
+ * the last TEMP_TELEMETRY_SAMPLES. The buffer is dumped on demand by
+ * M156 as CSV or binary to the serial or as CSV to the SD card.
+ *
+ * Binary record, little endian, HEATER_COUNT heaters and FAN_COUNT fans:
+ *   uint16 ms                low 16 bits of millis()
+ *   int16  temp[heaters]     1/10 C
+ *   int16  target[heaters]   C
+ *   uint8  output[heaters]   soft_pwm 0-255
+ *   uint8  fan[fans]         speed 0-255
+ */
+
+#ifndef _TELEMETRY_H_
+#define _TELEMETRY_H_
+
+#if ENABLED(TEMP_TELEMETRY)
+
+  #define TELEMETRY_RECORD_SIZE (2 + 5 * (HEATER_COUNT) + (FAN_COUNT))
+
+  typedef struct {
+    uint16_t  ms;
+    int16_t   temp[HEATER_COUNT],
+              target[HEATER_COUNT];
+    uint8_t   output[HEATER_COUNT];
+    #if FAN_COUNT > 0
+      uint8_t fan[FAN_COUNT];
+    #endif
+  } telemetry_sample_t;
+
+  class Telemetry {
+
+    public: /** Constructor */
+
+      Telemetry() {};
+
+    public: /** Public Parameters */
+
+      static bool     recording;
+      static uint8_t  interval;   // Spins (100ms) between samples
+
+    public: /** Public Function */
+
+      static void reset();
+      static void sample();
+      static void report_state();
+
+      static void dump_csv();
+      static void dump_binary();
+      #if HAS_SDSUPPORT
+        static void dump_sd();
+      #endif
+
+    private: /** Private Parameters */
+
+      static telemetry_sample_t samples[TEMP_TELEMETRY_SAMPLES];
+      static uint16_t head,       // Index of the next sample to be written
+                      count;      // Number of valid samples
+      static uint8_t  spins;
+
+    private: /** Private Function */
+
+      static const telemetry_sample_t* get_sample(const uint16_t i);
+      static void csv_header(char *line);
+      static void csv_line(char *line, const telemetry_sample_t * const s, const uint32_t ms);
+
+  };
+
+  extern Telemetry telemetry;
+
+#endif // ENABLED(TEMP_TELEMETRY)
+
+#endif /* _TELEMETRY_H_ */
@@ -50,6 +50,214 @@ void out_of_range_error(const char* p_edge) {
   #endif
 #endif
 
+#if ENABLED(ABL_ADAPTIVE_PROBING)
+
+  // Flags of the grid points for the adaptive probing
+  #define ABL_AP_PROBED   0x01  // Probed, or unreachable
+  #define ABL_AP_WANT     0x02  // To be probed in this round
+  #define ABL_AP_ACTIVE   0x04  // The cell at this point (its front-left corner) is checked at this level
+  #define ABL_AP_NEXT     0x08  // The cell at this point is checked at the next level
+
+  /**
+   * Probe the wanted grid points, always going to the nearest one.
+   * The distance is the larger of the X and Y moves, as the axes move together.
+   * Return the last Z measured or NAN on a probing failure.
+   */
+  static float abl_adaptive_probe_wanted(uint8_t (&flags)[GRID_MAX_POINTS_X][GRID_MAX_POINTS_Y], uint8_t &count, float &xProbe, float &yProbe,
+                                         const float zoffset, const bool stow, const int verbose_level, const bool faux
+  ) {
+    float measured_z = 0.0;
+
+    for (;;) {
+      int8_t  px = -1, py = -1;
+      float   best = 0.0;
+
+      for (uint8_t x = 0; x < GRID_MAX_POINTS_X; x++) {
+        for (uint8_t y = 0; y < GRID_MAX_POINTS_Y; y++) {
+          if (!(flags[x][y] & ABL_AP_WANT)) continue;
+          const float dist = max(FABS(abl.bilinear_start[X_AXIS] + abl.bilinear_grid_spacing[X_AXIS] * x - xProbe),
+                                 FABS(abl.bilinear_start[Y_AXIS] + abl.bilinear_grid_spacing[Y_AXIS] * y - yProbe));
+          if (px < 0 || dist < best) { px = x; py = y; best = dist; }
+        }
+      }
+      if (px < 0) return measured_z;
+
+      flags[px][py] = (flags[px][py] & ~ABL_AP_WANT) | ABL_AP_PROBED;
+
+      const float rx = abl.bilinear_start[X_AXIS] + abl.bilinear_grid_spacing[X_AXIS] * px,
+                  ry = abl.bilinear_start[Y_AXIS] + abl.bilinear_grid_spacing[Y_AXIS] * py;
+
+      #if IS_KINEMATIC
+        // Avoid probing outside the round or hexagonal area
+        if (!mechanics.position_is_reachable_by_probe(rx, ry)) continue;
+      #endif
+
+      xProbe = rx;
+      yProbe = ry;
+      measured_z = faux ? 0.001 * random(-100, 101) : probe.check_pt(xProbe, yProbe, stow, verbose_level);
+      if (isnan(measured_z)) return NAN;
+
+      abl.z_values[px][py] = measured_z + zoffset;
+      count++;
+      printer.idle();
+    }
+  }
+
+  /**
+   * Bilinear interpolation of grid point x, y from the corners of the cell x0, y0 - x1, y1
+   */
+  static float abl_adaptive_bilinear(const uint8_t x0, const uint8_t y0, const uint8_t x1, const uint8_t y1, const uint8_t x, const uint8_t y) {
+    const float tx = float(x - x0) / (x1 - x0),
+                ty = float(y - y0) / (y1 - y0),
+                zf = abl.z_values[x0][y0] + (abl.z_values[x1][y0] - abl.z_values[x0][y0]) * tx,
+                zb = abl.z_values[x0][y1] + (abl.z_values[x1][y1] - abl.z_values[x0][y1]) * tx;
+    return zf + (zb - zf) * ty;
+  }
+
+  /**
+   * Adaptive probing of the bilinear grid (G29 K)
+   *
+   * Probe a coarse lattice of the grid, then check each of its cells by probing the
+   * center: if it's within 'tolerance' of the bilinear interpolation of the corners
+   * the rest of the cell is interpolated, otherwise the cell is probed at half the
+   * spacing and its four quarters are checked at the next level, down to the grid.
+   * Unreachable points are left NAN for extrapolate_unprobed_bed_level.
+   *
+   * Return the last Z measured or NAN on a probing failure.
+   */
+  static float abl_adaptive_probing(const float tolerance, const float zoffset, const bool stow, const int verbose_level, const bool faux) {
+
+    uint8_t flags[GRID_MAX_POINTS_X][GRID_MAX_POINTS_Y] = { { 0 } },
+            count = 0;
+
+    float xProbe = mechanics.current_position[X_AXIS] + probe.offset[X_AXIS],
+          yProbe = mechanics.current_position[Y_AXIS] + probe.offset[Y_AXIS],
+          measured_z;
+
+    // Coarse lattice: a power of 2 spacing leaving at least 3 lines on each axis, plus the last line
+    uint8_t step = 1;
+    while (step * 4 <= min(GRID_MAX_POINTS_X, GRID_MAX_POINTS_Y) - 1) step <<= 1;
+
+    for (uint8_t x = 0; x < GRID_MAX_POINTS_X; x++) {
+      for (uint8_t y = 0; y < GRID_MAX_POINTS_Y; y++) {
+        abl.z_values[x][y] = NAN;
+        if ((x % step == 0 || x == GRID_MAX_POINTS_X - 1) && (y % step == 0 || y == GRID_MAX_POINTS_Y - 1))
+          flags[x][y] |= ABL_AP_WANT;
+        if (x % step == 0 && y % step == 0 && x < GRID_MAX_POINTS_X - 1 && y < GRID_MAX_POINTS_Y - 1)
+          flags[x][y] |= ABL_AP_ACTIVE;
+      }
+    }
+
+    measured_z = abl_adaptive_probe_wanted(flags, count, xProbe, yProbe, zoffset, stow, verbose_level, faux);
+
+    for (; step > 1 && !isnan(measured_z); step >>= 1) {
+
+      const uint8_t half = step >> 1;
+
+      // Probe the centers of the cells
+      for (uint8_t x0 = 0; x0 < GRID_MAX_POINTS_X - 1; x0 += step) {
+        const uint8_t xm = (x0 + min(x0 + step, GRID_MAX_POINTS_X - 1)) >> 1;
+        for (uint8_t y0 = 0; y0 < GRID_MAX_POINTS_Y - 1; y0 += step) {
+          const uint8_t ym = (y0 + min(y0 + step, GRID_MAX_POINTS_Y - 1)) >> 1;
+          if ((flags[x0][y0] & ABL_AP_ACTIVE) && !(flags[xm][ym] & ABL_AP_PROBED))
+            flags[xm][ym] |= ABL_AP_WANT;
+        }
+      }
+      measured_z = abl_adaptive_probe_wanted(flags, count, xProbe, yProbe, zoffset, stow, verbose_level, faux);
+      if (isnan(measured_z)) break;
+
+      // Interpolate the flat cells, probe the others at half the spacing
+      for (uint8_t x0 = 0; x0 < GRID_MAX_POINTS_X - 1; x0 += step) {
+        const uint8_t x1 = min(x0 + step, GRID_MAX_POINTS_X - 1), xm = (x0 + x1) >> 1;
+        for (uint8_t y0 = 0; y0 < GRID_MAX_POINTS_Y - 1; y0 += step) {
+          if (!(flags[x0][y0] & ABL_AP_ACTIVE)) continue;
+          const uint8_t y1 = min(y0 + step, GRID_MAX_POINTS_Y - 1), ym = (y0 + y1) >> 1;
+
+          if (FABS(abl.z_values[xm][ym] - abl_adaptive_bilinear(x0, y0, x1, y1, xm, ym)) <= tolerance) {
+            for (uint8_t x = x0; x <= x1; x++)
+              for (uint8_t y = y0; y <= y1; y++)
+                if (!(flags[x][y] & ABL_AP_PROBED)) abl.z_values[x][y] = abl_adaptive_bilinear(x0, y0, x1, y1, x, y);
+          }
+          else {
+            const uint8_t xs[3] = { x0, xm, x1 }, ys[3] = { y0, ym, y1 };
+            for (uint8_t i = 0; i < 3; i++)
+              for (uint8_t j = 0; j < 3; j++)
+                if (!(flags[xs[i]][ys[j]] & ABL_AP_PROBED)) flags[xs[i]][ys[j]] |= ABL_AP_WANT;
+            for (uint8_t x = x0; x < x1; x += half)
+              for (uint8_t y = y0; y < y1; y += half)
+                flags[x][y] |= ABL_AP_NEXT;
+          }
+        }
+      }
+      measured_z = abl_adaptive_probe_wanted(flags, count, xProbe, yProbe, zoffset, stow, verbose_level, faux);
+
+      // The quarters of the probed cells are the cells of the next level
+      for (uint8_t x = 0; x < GRID_MAX_POINTS_X; x++)
+        for (uint8_t y = 0; y < GRID_MAX_POINTS_Y; y++)
+          flags[x][y] = (flags[x][y] & ~(ABL_AP_ACTIVE | ABL_AP_NEXT)) | ((flags[x][y] & ABL_AP_NEXT) ? ABL_AP_ACTIVE : 0);
+    }
+
+    SERIAL_MV("Adaptive probing: ", (int)count);
+    SERIAL_EMV(" points of ", GRID_MAX_POINTS);
+
+    return measured_z;
+  }
+
+#endif // ABL_ADAPTIVE_PROBING
+
+#if ENABLED(ABL_PRINT_AREA_PROBING)
+
+  /**
+   * Grid index range of the print area set by M555, or scanned from the
+   * SD file being printed, widened by ABL_PRINT_AREA_MARGIN to whole cells.
+   * Return false to probe the whole grid: no print area, a stored mesh that
+   * is incomplete or of another geometry, or a print area over the grid.
+   */
+  static bool abl_print_area_grid(uint8_t lo[2], uint8_t hi[2]) {
+    float area_min[2], area_max[2];
+
+    bool found = abl.print_area_set;
+    abl.print_area_set = false; // M555 is for one G29
+
+    if (found) {
+      COPY_ARRAY(area_min, abl.print_area_min);
+      COPY_ARRAY(area_max, abl.print_area_max);
+    }
+    #if HAS_SDSUPPORT
+      else
+        found = IS_SD_PRINTING && card.scan_print_area(area_min, area_max);
+    #endif
+
+    if (!found) return false;
+
+    // The stored mesh is kept outside the print area
+    for (uint8_t x = 0; x < GRID_MAX_POINTS_X; x++)
+      for (uint8_t y = 0; y < GRID_MAX_POINTS_Y; y++)
+        if (isnan(abl.z_values[x][y])) return false;
+
+    const uint8_t points[2] = { GRID_MAX_POINTS_X, GRID_MAX_POINTS_Y };
+    LOOP_XY(i) {
+      const float first = FLOOR((area_min[i] - (ABL_PRINT_AREA_MARGIN) - abl.bilinear_start[i]) / abl.bilinear_grid_spacing[i]),
+                  last  = CEIL((area_max[i] + (ABL_PRINT_AREA_MARGIN) - abl.bilinear_start[i]) / abl.bilinear_grid_spacing[i]);
+      lo[i] = constrain(first, 0, points[i] - 1);
+      hi[i] = constrain(last, 0, points[i] - 1);
+    }
+
+    if (lo[X_AXIS] == 0 && lo[Y_AXIS] == 0 && hi[X_AXIS] == GRID_MAX_POINTS_X - 1 && hi[Y_AXIS] == GRID_MAX_POINTS_Y - 1)
+      return false;
+
+    SERIAL_MV("Print area X", area_min[X_AXIS]);
+    SERIAL_MV(":", area_max[X_AXIS]);
+    SERIAL_MV(" Y", area_min[Y_AXIS]);
+    SERIAL_MV(":", area_max[Y_AXIS]);
+    SERIAL_MV(" probing ", (int)((hi[X_AXIS] - lo[X_AXIS] + 1) * (hi[Y_AXIS] - lo[Y_AXIS] + 1)));
+    SERIAL_EMV(" points of ", GRID_MAX_POINTS);
+
+    return true;
+  }
+
+#endif // ABL_PRINT_AREA_PROBING
+
 /**
  * G29: Detailed Z probe, probes the bed at 3 or more points.
  *      Will fail if the printer has not been homed with G28.
@@ -97,6 +305,16 @@ void out_of_range_error(const char* p_edge) {
  *
  *  Z  Supply an additional Z probe offset
  *
+ *  K  Adaptive probing, with ABL_ADAPTIVE_PROBING. Probe a coarse grid and probe
+ *     the full grid only where the bed deviates more than K mm (default
+ *     ABL_ADAPTIVE_TOLERANCE) from the bilinear interpolation of the coarse grid.
+ *     Example: "G29 K0.03"
+ *
+ *  O  With ABL_PRINT_AREA_PROBING, probe only the grid points under the print area
+ *     set by M555, or scanned from the SD file being printed, plus ABL_PRINT_AREA_MARGIN.
+ *     The rest of the stored mesh is kept, moved by the mean change of the probed points.
+ *     On by default, "G29 O0" probes the whole grid.
+ *
  * Extra parameters with PROBE_MANUALLY:
  *
  *  To do manual probing simply repeat G29 until the procedure is complete.
@@ -215,6 +433,13 @@ inline void gcode_G29(void) {
 
       ABL_VAR float zoffset = 0.0;
 
+      #if ENABLED(ABL_ADAPTIVE_PROBING)
+        ABL_VAR float adaptive_tolerance = 0.0;
+      #endif
+      #if ENABLED(ABL_PRINT_AREA_PROBING)
+        ABL_VAR bool use_print_area = false;
+      #endif
+
     #elif ENABLED(AUTO_BED_LEVELING_LINEAR)
 
       ABL_VAR int indexIntoAB[GRID_MAX_POINTS_X][GRID_MAX_POINTS_Y];
@@ -290,6 +515,8 @@ inline void gcode_G29(void) {
           abl.z_values[i][j] = rz;
           #if ENABLED(ABL_BILINEAR_SUBDIVISION)
             abl.virt_interpolate();
+          #elif ENABLED(ABL_BICUBIC_INTERPOLATION)
+            abl.bicubic_interpolate();
           #endif
           bedlevel.set_bed_leveling_enabled(abl_should_enable);
         }
@@ -342,6 +569,18 @@ inline void gcode_G29(void) {
 
       zoffset = parser.linearval('Z');
 
+      #if ENABLED(ABL_ADAPTIVE_PROBING)
+        adaptive_tolerance = parser.seen('K') ? parser.linearval('K', ABL_ADAPTIVE_TOLERANCE) : 0.0;
+      #endif
+
+      #if ENABLED(ABL_PRINT_AREA_PROBING)
+        use_print_area = (!parser.seen('O') || parser.value_bool())
+          #if ENABLED(ABL_ADAPTIVE_PROBING)
+            && adaptive_tolerance == 0.0
+          #endif
+        ;
+      #endif
+
     #endif
 
     #if ABL_GRID
@@ -640,6 +879,23 @@ inline void gcode_G29(void) {
 
       bool zig = PR_OUTER_END & 1;  // Always end at RIGHT and BACK_PROBE_BED_POSITION
 
+      #if ENABLED(ABL_PRINT_AREA_PROBING)
+        uint8_t area_lo[2], area_hi[2];
+        uint16_t area_count = 0;
+        float area_shift = 0.0;
+        if (use_print_area) use_print_area = abl_print_area_grid(area_lo, area_hi);
+      #endif
+
+      #if ENABLED(ABL_ADAPTIVE_PROBING)
+        if (adaptive_tolerance > 0.0) {
+          measured_z = abl_adaptive_probing(adaptive_tolerance, zoffset, stow_probe_after_each, verbose_level, faux);
+          // The grid has been overwritten
+          if (isnan(measured_z)) bedlevel.leveling_active = false;
+          abl_should_enable = false;
+        }
+        else
+      #endif
+
       // Outer loop is Y with PROBE_Y_FIRST disabled
       for (uint8_t PR_OUTER_VAR = 0; PR_OUTER_VAR < PR_OUTER_END && !isnan(measured_z); PR_OUTER_VAR++) {
 
@@ -676,6 +932,11 @@ inline void gcode_G29(void) {
             if (!mechanics.position_is_reachable_by_probe(xProbe, yProbe)) continue;
           #endif
 
+          #if ENABLED(ABL_PRINT_AREA_PROBING)
+            if (use_print_area && !(WITHIN(xCount, area_lo[X_AXIS], area_hi[X_AXIS]) && WITHIN(yCount, area_lo[Y_AXIS], area_hi[Y_AXIS])))
+              continue;
+          #endif
+
           measured_z = faux ? 0.001 * random(-100, 101) : probe.check_pt(xProbe, yProbe, stow_probe_after_each, verbose_level);
 
           if (isnan(measured_z)) {
@@ -683,6 +944,13 @@ inline void gcode_G29(void) {
             break;
           }
 
+          #if ENABLED(ABL_PRINT_AREA_PROBING)
+            if (use_print_area) {
+              area_shift += measured_z + zoffset - abl.z_values[xCount][yCount];
+              area_count++;
+            }
+          #endif
+
           #if ENABLED(AUTO_BED_LEVELING_LINEAR)
 
             mean += measured_z;
@@ -705,6 +973,18 @@ inline void gcode_G29(void) {
         } // inner
       } // outer
 
+      #if ENABLED(ABL_PRINT_AREA_PROBING)
+        // Move the kept mesh by the mean change of the probed points,
+        // so another plate or bed temperature leaves no step at the border
+        if (use_print_area && area_count && !isnan(measured_z)) {
+          area_shift /= area_count;
+          for (uint8_t x = 0; x < GRID_MAX_POINTS_X; x++)
+            for (uint8_t y = 0; y < GRID_MAX_POINTS_Y; y++)
+              if (!(WITHIN(x, area_lo[X_AXIS], area_hi[X_AXIS]) && WITHIN(y, area_lo[Y_AXIS], area_hi[Y_AXIS])))
+                abl.z_values[x][y] += area_shift;
+        }
+      #endif
+
     #elif ENABLED(AUTO_BED_LEVELING_3POINT)
 
       // Probe at 3 arbitrary points
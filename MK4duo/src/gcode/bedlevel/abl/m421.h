@@ -61,6 +61,8 @@
       abl.z_values[ix][iy] = parser.value_linear_units() + (hasQ ? abl.z_values[ix][iy] : 0);
       #if ENABLED(ABL_BILINEAR_SUBDIVISION)
         abl.virt_interpolate();
+      #elif ENABLED(ABL_BICUBIC_INTERPOLATION)
+        abl.bicubic_interpolate();
       #endif
     }
   }
@@ -0,0 +1,62 @@
+/**
+ * MK4duo Firmware for 3D Printer, Laser and CNC
+ *
+ * Based on Marlin, Sprinter and grbl
+ * Copyright (C) 2011 Camiel Gubbels / Erik van der Zalm
+ * Copyright (C) 2013 Alberto Cotronei @MagoKimbra
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+/**
+ * mcode
+ *
+ * Copyright (C) 2017 Alberto Cotronei @MagoKimbra
+ */
+
+#if ENABLED(ABL_PRINT_AREA_PROBING)
+
+  #define CODE_M555
+
+  /**
+   * M555: Set the print area of the next G29, that probes only the
+   *       grid points under it and keeps the stored mesh elsewhere.
+   *       Sent by the host or the start G-code of the slicer.
+   *
+   * Usage:
+   *   M555 X<left> Y<front> W<width> H<depth>
+   *   M555 without parameters reports the print area.
+   */
+  inline void gcode_M555(void) {
+    if (parser.seenval('X') && parser.seenval('Y') && parser.seenval('W') && parser.seenval('H')) {
+      abl.print_area_min[X_AXIS] = NATIVE_X_POSITION(parser.linearval('X'));
+      abl.print_area_min[Y_AXIS] = NATIVE_Y_POSITION(parser.linearval('Y'));
+      abl.print_area_max[X_AXIS] = abl.print_area_min[X_AXIS] + parser.linearval('W');
+      abl.print_area_max[Y_AXIS] = abl.print_area_min[Y_AXIS] + parser.linearval('H');
+      abl.print_area_set = abl.print_area_max[X_AXIS] >= abl.print_area_min[X_AXIS]
+                        && abl.print_area_max[Y_AXIS] >= abl.print_area_min[Y_AXIS];
+      if (!abl.print_area_set) SERIAL_LM(ER, "M555 print area is empty");
+    }
+    else if (abl.print_area_set) {
+      SERIAL_MV("Print area X", abl.print_area_min[X_AXIS]);
+      SERIAL_MV(" Y", abl.print_area_min[Y_AXIS]);
+      SERIAL_MV(" W", abl.print_area_max[X_AXIS] - abl.print_area_min[X_AXIS]);
+      SERIAL_EMV(" H", abl.print_area_max[Y_AXIS] - abl.print_area_min[Y_AXIS]);
+    }
+    else
+      SERIAL_EM("No print area");
+  }
+
+#endif // ENABLED(ABL_PRINT_AREA_PROBING)
@@ -38,6 +38,7 @@
  *    Y = Max Y Jerk (units/sec^2)
  *    Z = Max Z Jerk (units/sec^2)
  *    E = Max E Jerk (units/sec^2)
+ *    J = Junction Deviation (units), 0 to limit the corners by jerk
  */
 inline void gcode_M205(void) {
 
@@ -50,4 +51,10 @@ inline void gcode_M205(void) {
   if (parser.seen('Y')) mechanics.max_jerk[Y_AXIS] = parser.value_linear_units();
   if (parser.seen('Z')) mechanics.max_jerk[Z_AXIS] = parser.value_linear_units();
   if (parser.seen('E')) mechanics.max_jerk[E_AXIS + TARGET_EXTRUDER] = parser.value_linear_units();
+  #if ENABLED(JUNCTION_DEVIATION)
+    if (parser.seen('J')) {
+      mechanics.junction_deviation_mm = parser.value_linear_units();
+      NOLESS(mechanics.junction_deviation_mm, 0.0);
+    }
+  #endif
 }
@@ -43,6 +43,10 @@
    *
    *   C[float] Kc term
    *   L[float] LPQ length
+   *
+   * With HEATER_CONTROL_SCHEDULER:
+   *
+   *   T[int]   Control period in ms (10 - 5000, not less than the ADC refresh time)
    */
   inline void gcode_M301(void) {
 
@@ -60,6 +64,9 @@
       if (parser.seen('L')) thermalManager.lpq_len = parser.value_float();
       NOMORE(thermalManager.lpq_len, LPQ_MAX_LEN);
     #endif
+    #if ENABLED(HEATER_CONTROL_SCHEDULER)
+      if (parser.seen('T')) heaters[h].control_period = constrain(parser.value_int(), HEATER_CONTROL_MIN_PERIOD, 5000);
+    #endif
 
     thermalManager.updatePID();
 
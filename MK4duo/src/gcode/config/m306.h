@@ -0,0 +1,69 @@
+/**
+ * MK4duo Firmware for 3D Printer, Laser and CNC
+ *
+ * Based on Marlin, Sprinter and grbl
+ * Copyright (C) 2011 Camiel Gubbels / Erik van der Zalm
+ * Copyright (C) 2013 Alberto Cotronei @MagoKimbra
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+/**
+ * mcode
+ *
+ * Copyright (C) 2017 Alberto Cotronei @MagoKimbra
+ */
+
+#if ENABLED(MPC_HOTEND)
+
+  #define CODE_M306
+
+  /**
+   * M306: Set hotend model parameters for MPC_HOTEND
+   *
+   *   H[hotend] H = 0-3 Hotend
+   *
+   *   P[float] Heater power (W)
+   *   C[float] Block heat capacity (J/K)
+   *   A[float] Ambient heat transfer coefficient, part fan off (W/K)
+   *   F[float] Ambient heat transfer coefficient, part fan at full speed (W/K)
+   *   E[float] Filament heat capacity per mm (J/K/mm)
+   */
+  inline void gcode_M306(void) {
+
+    int8_t h = parser.seen('H') ? parser.value_int() : 0; // hotend being updated
+
+    if (!commands.get_target_heater(h)) return;
+
+    Heater *act = &heaters[h];
+    if (act->type != IS_HOTEND) return;
+
+    if (parser.seen('P')) act->mpc_heater_power           = parser.value_float();
+    if (parser.seen('C')) act->mpc_block_heat_capacity    = parser.value_float();
+    if (parser.seen('A')) act->mpc_ambient_xfer_coeff     = parser.value_float();
+    if (parser.seen('F')) act->mpc_ambient_xfer_coeff_fan = parser.value_float();
+    if (parser.seen('E')) act->mpc_filament_heat_capacity = parser.value_float();
+
+    NOLESS(act->mpc_heater_power, 0.1);
+    NOLESS(act->mpc_block_heat_capacity, 0.1);
+    NOLESS(act->mpc_ambient_xfer_coeff, 0.0);
+    NOLESS(act->mpc_ambient_xfer_coeff_fan, 0.0);
+    NOLESS(act->mpc_filament_heat_capacity, 0.0);
+
+    act->print_MPC(h);
+
+  }
+
+#endif // MPC_HOTEND
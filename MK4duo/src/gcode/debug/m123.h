@@ -0,0 +1,46 @@
+/**
+ * MK4duo Firmware for 3D Printer, Laser and CNC
+ *
+ * Based on Marlin, Sprinter and grbl
+ * Copyright (C) 2011 Camiel Gubbels / Erik van der Zalm
+ * Copyright (C) 2013 Alberto Cotronei @MagoKimbra
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+/**
+ * mcode
+ *
+ * Copyright (C) 2017 Alberto Cotronei @MagoKimbra
+ */
+
+#if ENABLED(MOTION_STATS)
+
+  #define CODE_M123
+
+  /**
+   * M123: Report motion pipeline throughput
+   *
+   *  Prints G-code lines/s, planner blocks/s and step events/s
+   *  measured since the last reset.
+   *
+   *  R   Reset the counters after the report
+   */
+  inline void gcode_M123(void) {
+    motionstats.report();
+    if (parser.seen('R')) motionstats.reset();
+  }
+
+#endif // ENABLED(MOTION_STATS)
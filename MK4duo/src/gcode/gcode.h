@@ -31,6 +31,7 @@
 #include "bedlevel/m420.h"                // Set ABL, MBL and UBL
 #include "bedlevel/abl/g29.h"             // ABL
 #include "bedlevel/abl/m421.h"            // Set ABL Manual
+#include "bedlevel/abl/m555.h"            // Set ABL print area
 #include "bedlevel/mbl/g29.h"             // MBL
 #include "bedlevel/mbl/m421.h"            // Set MBL Manual
 #include "bedlevel/ubl/g26.h"             // UBL Mesh Validation
@@ -57,6 +58,7 @@
 #include "config/m301.h"                  // Set PID parameters Heater
 #include "config/m302.h"                  // Allow cold extrudes
 #include "config/m305.h"                  // Set thermistor and ADC parameters
+#include "config/m306.h"                  // Set hotend model parameters
 #include "config/m595.h"                  // Set AD595 offset & Gain
 #include "config/m900.h"                  // Set and/or Get advance K factor
 #include "config/m906.h"                  // Set Alligator motor currents or Set motor current in milliamps with have a TMC2130 driver
@@ -89,6 +91,8 @@
 // Debug Commands
 #include "debug/m43.h"
 #include "debug/m44_pre_table.h"          // Debug Code Info
+#include "debug/m123.h"                   // Motion throughput stats
+#include "debug/m124.h"                   // CPU cycle profiler
 
 // Delta Commands
 #include "delta/g33_type1.h"              // Autocalibration 7 point
@@ -130,6 +134,7 @@
 #include "host/m530.h"                    // Enables explicit printing mode
 #include "host/m531.h"                    // Define filename being printed
 #include "host/m532.h"                    // Update current print state progress
+#include "host/m576.h"                    // Binary command stream
 
 // LCD Commands
 #include "lcd/m0_m1.h"
@@ -204,10 +209,12 @@
 #include "temperature/m105.h"
 #include "temperature/m108.h"
 #include "temperature/m109.h"
+#include "temperature/m116.h"             // Wait for deferred heater waits
 #include "temperature/m140.h"
 #include "temperature/m141.h"
 #include "temperature/m142.h"
 #include "temperature/m155.h"
+#include "temperature/m156.h"             // Heater telemetry
 #include "temperature/m190.h"
 #include "temperature/m191.h"
 #include "temperature/m192.h"
@@ -99,5 +99,12 @@ inline void gcode_M115(void) {
       SERIAL_LM(CAP, "EMERGENCY_PARSER:0");
     #endif
 
+    // BINARY_PROTOCOL (M576)
+    #if ENABLED(BINARY_PROTOCOL)
+      SERIAL_LM(CAP, "BINARY_PROTOCOL:1");
+    #else
+      SERIAL_LM(CAP, "BINARY_PROTOCOL:0");
+    #endif
+
   #endif // EXTENDED_CAPABILITIES_REPORT
 }
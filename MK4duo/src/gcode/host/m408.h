@@ -155,6 +155,9 @@
         }
         break;
       case 3:
+        #if ENABLED(SD_GCODE_INFO_CACHE)
+          card.gcode_info_finish();
+        #endif
         SERIAL_EM(",");
         SERIAL_MSG("\"printer.currentLayer\":");
         #if HAS_SDSUPPORT
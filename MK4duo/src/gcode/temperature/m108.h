@@ -33,6 +33,11 @@
   /**
    * M108: Cancel heatup and wait for the hotend and bed, this G-code is asynchronously handled in the get_serial_commands() parser
    */
-  inline void gcode_M108(void) { thermalManager.wait_for_heatup = false; }
+  inline void gcode_M108(void) {
+    thermalManager.wait_for_heatup = false;
+    #if ENABLED(ASYNC_HEATER_WAIT)
+      thermalManager.cancel_pending_heaters();
+    #endif
+  }
 
 #endif
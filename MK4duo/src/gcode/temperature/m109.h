@@ -61,7 +61,7 @@
       planner.autotemp_M104_M109();
     #endif
 
-    thermalManager.wait_heater(&heaters[EXTRUDER_IDX], no_wait_for_cooling);
+    thermalManager.wait_heater_command(&heaters[EXTRUDER_IDX], no_wait_for_cooling);
   }
 
 #endif // HAS_TEMP_HOTEND
@@ -0,0 +1,45 @@
+/**
+ * MK4duo Firmware for 3D Printer, Laser and CNC
+ *
+ * Based on Marlin, Sprinter and grbl
+ * Copyright (C) 2011 Camiel Gubbels / Erik van der Zalm
+ * Copyright (C) 2013 Alberto Cotronei @MagoKimbra
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+/**
+ * mcode
+ *
+ * Copyright (C) 2017 Alberto Cotronei @MagoKimbra
+ */
+
+#if ENABLED(ASYNC_HEATER_WAIT)
+
+  #define CODE_M116
+
+  /**
+   * M116: Wait for the heaters with a deferred M109-M190-M191-M192 wait.
+   *       M116 is not independent, so the wait is done by the command
+   *       barrier before the handler runs.
+   *
+   *  S<bool>   S0 blocking heater waits, S1 deferred heater waits
+   */
+  inline void gcode_M116(void) {
+    thermalManager.wait_pending_heaters();
+    if (parser.seen('S')) thermalManager.async_wait = parser.value_bool();
+  }
+
+#endif // ASYNC_HEATER_WAIT
@@ -0,0 +1,72 @@
+/**
+ * MK4duo Firmware for 3D Printer, Laser and CNC
+ *
+ * Based on Marlin, Sprinter and grbl
+ * Copyright (C) 2011 Camiel Gubbels / Erik van der Zalm
+ * Copyright (C) 2013 Alberto Cotronei @MagoKimbra
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+/**
+ * mcode
+ *
+ * Copyright (C) 2017 Alberto Cotronei @MagoKimbra
+ */
+
+#if ENABLED(TEMP_TELEMETRY)
+
+  #define CODE_M156
+
+  /**
+   * M156: Heater telemetry
+   *
+   *  S<bool>   Start (S1) or stop (S0) recording
+   *  I<int>    Record a sample every I temperature spins of 100ms
+   *  R         Clear the recorded samples
+   *  D<int>    Dump the samples:
+   *              D0 CSV to serial
+   *              D1 binary to serial
+   *              D2 CSV to the SD file TEMP_TELEMETRY_FILE
+   *
+   *  Without parameters report the recording state
+   */
+  inline void gcode_M156(void) {
+
+    if (parser.seen('S')) telemetry.recording = parser.value_bool();
+
+    if (parser.seenval('I')) {
+      telemetry.interval = parser.value_byte();
+      NOLESS(telemetry.interval, 1);
+    }
+
+    if (parser.seen('D')) {
+      switch (parser.value_int()) {
+        case 0: telemetry.dump_csv(); break;
+        case 1: telemetry.dump_binary(); break;
+        #if HAS_SDSUPPORT
+          case 2: telemetry.dump_sd(); break;
+        #endif
+        default: break;
+      }
+    }
+
+    if (parser.seen('R')) telemetry.reset();
+
+    if (!parser.seen('D')) telemetry.report_state();
+
+  }
+
+#endif // TEMP_TELEMETRY
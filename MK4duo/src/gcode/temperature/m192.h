@@ -41,7 +41,7 @@
     bool no_wait_for_heating = parser.seen('S');
     if (no_wait_for_heating || parser.seen('R')) heaters[COOLER_INDEX].setTarget(parser.value_celsius());
 
-    thermalManager.wait_heater(&heaters[COOLER_INDEX], no_wait_for_cooling);
+    thermalManager.wait_heater_command(&heaters[COOLER_INDEX], no_wait_for_cooling);
   }
 
 #endif // HAS_TEMP_COOLER
@@ -34,8 +34,11 @@
  *       S<temperature> sets the target temperature. (default target temperature = 150C)
  *       H<hotend> (-1 for the bed, -2 for chamber, -3 for cooler) (default 0)
  *       C<cycles>
- *       R<method> (0 - 3)
+ *       R<method> (0 - 3, 4 hotend model with MPC_HOTEND)
  *       U<bool> with a non-zero value will apply the result to current settings
+ *       A       autotune all the PID hotends at S, the bed at B<temperature> (default 70C)
+ *               and the chamber at D<temperature> (default 50C) at the same time, methods 0 - 3.
+ *               Check the power supply can feed all the heaters at once.
  */
 inline void gcode_M303(void) {
 
@@ -45,44 +48,67 @@ inline void gcode_M303(void) {
     uint8_t     method  = parser.intval('R', 0);
     const bool  store   = parser.boolval('U');
 
-    const int16_t temp = parser.celsiusval('S', h < 0 ? 70 : 200);
+    const bool    all   = parser.seen('A');
+    const int16_t temp  = parser.celsiusval('S', h < 0 && !all ? 70 : 200);
 
-    if (!commands.get_target_heater(h)) return;
+    if (!all && !commands.get_target_heater(h)) return;
 
     #if DISABLED(BUSY_WHILE_HEATING)
       KEEPALIVE_STATE(NOT_BUSY);
     #endif
 
-    SERIAL_EM(MSG_PID_AUTOTUNE_START);
-
-    if (heaters[h].type == IS_HOTEND)
-      SERIAL_MV("Hotend:", h);
-    #if HAS_TEMP_BED
-      else if (heaters[h].type == IS_BED)
-        SERIAL_MSG("BED");
-    #endif
-    #if HAS_TEMP_CHAMBER
-      else if(heaters[h].type == IS_CHAMBER)
-        SERIAL_MSG("CHAMBER");
-    #endif
-    #if HAS_TEMP_COOLER
-      else if(heaters[h].type == IS_COOLER)
-        SERIAL_MSG("COOLER");
-    #endif
-
     NOLESS(cycle, 5);
     NOMORE(cycle, 20);
 
     NOLESS(method, 0);
-    NOMORE(method, 3);
+    #if ENABLED(MPC_HOTEND)
+      NOMORE(method, all ? 3 : 4);
+    #else
+      NOMORE(method, 3);
+    #endif
 
-    SERIAL_MV(" Temp:", temp);
-    SERIAL_MV(" Cycles:", cycle);
-    SERIAL_MV(" Method:", method);
-    if (store) SERIAL_MSG(" Apply result");
-    SERIAL_EOL();
+    SERIAL_EM(MSG_PID_AUTOTUNE_START);
 
-    thermalManager.PID_autotune(&heaters[h], temp, cycle, method, store);
+    if (all) {
+      const int16_t bed_temp      = parser.celsiusval('B', 70),
+                    chamber_temp  = parser.celsiusval('D', 50);
+      SERIAL_MV("All Temp:", temp);
+      #if HAS_TEMP_BED
+        SERIAL_MV(" Bed:", bed_temp);
+      #endif
+      #if HAS_TEMP_CHAMBER
+        SERIAL_MV(" Chamber:", chamber_temp);
+      #endif
+      SERIAL_MV(" Cycles:", cycle);
+      SERIAL_MV(" Method:", method);
+      if (store) SERIAL_MSG(" Apply result");
+      SERIAL_EOL();
+      thermalManager.PID_autotune_all(temp, bed_temp, chamber_temp, cycle, method, store);
+    }
+    else {
+      if (heaters[h].type == IS_HOTEND)
+        SERIAL_MV("Hotend:", h);
+      #if HAS_TEMP_BED
+        else if (heaters[h].type == IS_BED)
+          SERIAL_MSG("BED");
+      #endif
+      #if HAS_TEMP_CHAMBER
+        else if(heaters[h].type == IS_CHAMBER)
+          SERIAL_MSG("CHAMBER");
+      #endif
+      #if HAS_TEMP_COOLER
+        else if(heaters[h].type == IS_COOLER)
+          SERIAL_MSG("COOLER");
+      #endif
+
+      SERIAL_MV(" Temp:", temp);
+      SERIAL_MV(" Cycles:", cycle);
+      SERIAL_MV(" Method:", method);
+      if (store) SERIAL_MSG(" Apply result");
+      SERIAL_EOL();
+
+      thermalManager.PID_autotune(&heaters[h], temp, cycle, method, store);
+    }
 
     #if DISABLED(BUSY_WHILE_HEATING)
       KEEPALIVE_STATE(IN_HANDLER);
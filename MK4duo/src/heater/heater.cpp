@@ -55,6 +55,11 @@
       watch_next_ms       = 0;
     #endif
 
+    #if ENABLED(MPC_HOTEND)
+      mpc_model_temp      = 25.0;
+      mpc_ambient_temp    = 25.0;
+    #endif
+
     if (pin > 0) HAL::pinMode(pin, (hardwareInverted) ? OUTPUT_HIGH : OUTPUT_LOW);
 
     #if ENABLED(SUPPORT_MAX6675) || ENABLED(SUPPORT_MAX31855)
@@ -100,9 +105,26 @@
     #if ENABLED(PID_ADD_EXTRUSION_RATE)
       SERIAL_MV(" C", Kc);
     #endif
+    #if ENABLED(HEATER_CONTROL_SCHEDULER)
+      SERIAL_MV(" T", control_period);
+    #endif
     SERIAL_EOL();
   }
 
+  #if ENABLED(MPC_HOTEND)
+
+    void Heater::print_MPC(const uint8_t h/*=0*/) {
+      if (type != IS_HOTEND) return;
+      SERIAL_SMV(CFG, "  M306 H", (int)h);
+      SERIAL_MV(" P", mpc_heater_power);
+      SERIAL_MV(" C", mpc_block_heat_capacity);
+      SERIAL_MV(" A", mpc_ambient_xfer_coeff, 4);
+      SERIAL_MV(" F", mpc_ambient_xfer_coeff_fan, 4);
+      SERIAL_EMV(" E", mpc_filament_heat_capacity, 4);
+    }
+
+  #endif
+
   void Heater::sensor_print_parameters(const uint8_t h/*=0*/) {
 
     if (type == IS_HOTEND)
@@ -126,6 +148,9 @@
     SERIAL_LMV(CFG, " Pullup resistor value: ", sensor.pullupR, 1);
     SERIAL_LMV(CFG, " ADC low offset correction: ", sensor.adcLowOffset);
     SERIAL_LMV(CFG, " ADC high offset correction: ", sensor.adcHighOffset);
+    #if ENABLED(THERMISTOR_LUT)
+      if (WITHIN(sensor.type, 1, 9)) SERIAL_LMV(CFG, " Table max error: ", sensor.lut_error, 2);
+    #endif
 
   }
 
@@ -77,6 +77,20 @@
         millis_t  watch_next_ms;
       #endif
 
+      #if ENABLED(HEATER_CONTROL_SCHEDULER)
+        uint16_t  control_period;   // (ms) PID/MPC control loop period
+      #endif
+
+      #if ENABLED(MPC_HOTEND)
+        float     mpc_heater_power,
+                  mpc_block_heat_capacity,
+                  mpc_ambient_xfer_coeff,
+                  mpc_ambient_xfer_coeff_fan,
+                  mpc_filament_heat_capacity,
+                  mpc_model_temp,
+                  mpc_ambient_temp;
+      #endif
+
       TemperatureSensor sensor;
 
     private: /** Private Parameters */
@@ -91,6 +105,9 @@
 
       void setTarget(int16_t celsius);
       void print_PID(const uint8_t h=0);
+      #if ENABLED(MPC_HOTEND)
+        void print_MPC(const uint8_t h=0);
+      #endif
       void sensor_print_parameters(const uint8_t h=0);
 
       bool isON()         { return (this->sensor.type != 0 && this->target_temperature > 0); }
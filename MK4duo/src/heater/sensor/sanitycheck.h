@@ -62,6 +62,14 @@
   #endif
 #endif
 
+#if ENABLED(ADC_DMA_SCAN) && DISABLED(ARDUINO_ARCH_SAM)
+  #error "ADC_DMA_SCAN is only for Arduino Due."
+#endif
+
+#if ENABLED(THERMISTOR_LUT) && !WITHIN(THERMISTOR_LUT_SIZE, 16, 128)
+  #error "THERMISTOR_LUT_SIZE must be from 16 to 128."
+#endif
+
 // Every hotend needs a temp sensor
 #if HOTENDS > 0
   #if TEMP_SENSOR_0 == 0
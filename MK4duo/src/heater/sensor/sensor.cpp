@@ -139,25 +139,11 @@ float TemperatureSensor::GetTemperature(const uint8_t h) {
       return ((adcReading * (((HAL_VOLTAGE_PIN) * 100.0) / (AD_RANGE))) * this->ad595_gain) + this->ad595_offset;
   #endif
   if (WITHIN(s_type, 1, 9)) {
-    const float denom = (float)(AD_RANGE + (int)this->adcHighOffset - adcReading) - 0.5;
-    if (denom <= 0.0) return (ABS_ZERO);
-
-    const float resistance = this->pullupR * ((float)(adcReading - (int)this->adcLowOffset) + 0.5) / denom;
-    const float logResistance = LOG(resistance);
-    const float recipT = this->shA + this->shB * logResistance + this->shC * logResistance * logResistance * logResistance;
-
-    /*
-    SERIAL_MV("Debug denom:", denom, 5);
-    SERIAL_MV(" resistance:", resistance, 5);
-    SERIAL_MV(" logResistance:", logResistance, 5);
-    SERIAL_MV(" shA:", shA, 5);
-    SERIAL_MV(" shB:", shB, 5);
-    SERIAL_MV(" shC:", shC, 5);
-    SERIAL_MV(" recipT:", recipT, 5);
-    SERIAL_EOL();
-    */
-
-    return (recipT > 0.0) ? (1.0 / recipT) + (ABS_ZERO) : 2000.0;
+    #if ENABLED(THERMISTOR_LUT)
+      return LutTemperature(adcReading);
+    #else
+      return SteinhartHart(adcReading);
+    #endif
   }
   #if ENABLED(DHT_SENSOR)
     if (s_type == 11)
@@ -193,7 +179,103 @@ float TemperatureSensor::GetTemperature(const uint8_t h) {
 }
 
 void TemperatureSensor::CalcDerivedParameters() {
-	this->shB = 1.0 / this->beta;
-	const float lnR25 = LOG(this->r25);
-	this->shA = 1.0 / (25.0 - (ABS_ZERO)) - (this->shB * lnR25) - (this->shC * lnR25 * lnR25 * lnR25);
+  this->shB = 1.0 / this->beta;
+  const float lnR25 = LOG(this->r25);
+  this->shA = 1.0 / (25.0 - (ABS_ZERO)) - (this->shB * lnR25) - (this->shC * lnR25 * lnR25 * lnR25);
+  #if ENABLED(THERMISTOR_LUT)
+    if (WITHIN(this->type, 1, 9)) CalcLut();
+  #endif
 }
+
+float TemperatureSensor::SteinhartHart(const int16_t adcReading) {
+  const float denom = (float)(AD_RANGE + (int)this->adcHighOffset - adcReading) - 0.5;
+  if (denom <= 0.0) return (ABS_ZERO);
+
+  const float resistance = this->pullupR * ((float)(adcReading - (int)this->adcLowOffset) + 0.5) / denom;
+  const float logResistance = LOG(resistance);
+  const float recipT = this->shA + this->shB * logResistance + this->shC * logResistance * logResistance * logResistance;
+
+  /*
+  SERIAL_MV("Debug denom:", denom, 5);
+  SERIAL_MV(" resistance:", resistance, 5);
+  SERIAL_MV(" logResistance:", logResistance, 5);
+  SERIAL_MV(" shA:", shA, 5);
+  SERIAL_MV(" shB:", shB, 5);
+  SERIAL_MV(" shC:", shC, 5);
+  SERIAL_MV(" recipT:", recipT, 5);
+  SERIAL_EOL();
+  */
+
+  return (recipT > 0.0) ? (1.0 / recipT) + (ABS_ZERO) : 2000.0;
+}
+
+#if ENABLED(THERMISTOR_LUT)
+
+  #define LUT_MIN_TEMP  -20.0
+  #define LUT_MAX_TEMP  450.0
+  #define LUT_SCALE     16      // Table temperatures are in 1/16 degC
+
+  /**
+   * Build the ADC -> temperature table of the thermistor.
+   *
+   * The points between the two ends of the ADC range are spaced evenly
+   * in temperature, which puts them close together where the curve bends.
+   * The ADC reading of each point comes from the inverted Steinhart-Hart
+   * formula, and the temperature stored is the one of the rounded reading.
+   */
+  void TemperatureSensor::CalcLut() {
+
+    lut_count = 0;
+    AddLutPoint(0);
+
+    for (uint8_t k = 0; k < THERMISTOR_LUT_SIZE - 2; k++) {
+      const float recipT = 1.0 / (LUT_MAX_TEMP - (LUT_MAX_TEMP - LUT_MIN_TEMP) * k / (THERMISTOR_LUT_SIZE - 3) - (ABS_ZERO));
+
+      // Solve shA + shB * lnR + shC * lnR^3 = 1/T, exact for shC = 0
+      float lnR = (recipT - this->shA) / this->shB;
+      for (uint8_t i = 0; i < 3; i++)
+        lnR -= (this->shA + this->shB * lnR + this->shC * lnR * lnR * lnR - recipT) / (this->shB + 3.0 * this->shC * lnR * lnR);
+
+      const float resistance = EXP(lnR);
+      AddLutPoint(LROUND((resistance * (AD_RANGE + (int)this->adcHighOffset - 0.5) + this->pullupR * ((int)this->adcLowOffset - 0.5)) / (resistance + this->pullupR)));
+    }
+
+    AddLutPoint(AD_RANGE);
+
+    // Worst deviation from the formula in the table range, checked halfway between the points
+    lut_error = 0.0;
+    for (uint8_t i = 1; i < lut_count; i++) {
+      const int16_t adcReading = (lut_adc[i - 1] + lut_adc[i]) >> 1;
+      const float celsius = SteinhartHart(adcReading);
+      if (WITHIN(celsius, LUT_MIN_TEMP, LUT_MAX_TEMP))
+        NOLESS(lut_error, FABS(LutTemperature(adcReading) - celsius));
+    }
+  }
+
+  // Append a point, skipping readings already in the table
+  void TemperatureSensor::AddLutPoint(const int16_t adcReading) {
+    if ((lut_count && adcReading <= lut_adc[lut_count - 1]) || adcReading > AD_RANGE) return;
+    float celsius = SteinhartHart(adcReading);
+    NOMORE(celsius, 2000.0);
+    lut_adc[lut_count] = adcReading;
+    lut_temp[lut_count] = LROUND(celsius * LUT_SCALE);
+    lut_count++;
+  }
+
+  float TemperatureSensor::LutTemperature(const int16_t adcReading) {
+    uint8_t lo = 0, hi = lut_count - 1;
+
+    if (adcReading <= lut_adc[lo]) return lut_temp[lo] * (1.0 / (LUT_SCALE));
+    if (adcReading >= lut_adc[hi]) return lut_temp[hi] * (1.0 / (LUT_SCALE));
+
+    // Binary search of the segment holding the reading
+    while (hi - lo > 1) {
+      const uint8_t mid = (lo + hi) >> 1;
+      if (lut_adc[mid] <= adcReading) lo = mid; else hi = mid;
+    }
+
+    const int16_t celsius = lut_temp[lo] + (int32_t)(lut_temp[hi] - lut_temp[lo]) * (adcReading - lut_adc[lo]) / (lut_adc[hi] - lut_adc[lo]);
+    return celsius * (1.0 / (LUT_SCALE));
+  }
+
+#endif // ENABLED(THERMISTOR_LUT)
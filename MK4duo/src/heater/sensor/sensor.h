@@ -48,6 +48,18 @@ class TemperatureSensor {
             ad595_gain;
     #endif
 
+    #if ENABLED(THERMISTOR_LUT)
+      float lut_error;  // Max deviation of the table from the formula, degC
+    #endif
+
+  private: /** Private Parameters */
+
+    #if ENABLED(THERMISTOR_LUT)
+      int16_t lut_adc[THERMISTOR_LUT_SIZE],
+              lut_temp[THERMISTOR_LUT_SIZE];
+      uint8_t lut_count;
+    #endif
+
   public: /** Public Function */
 
     void CalcDerivedParameters();
@@ -55,6 +67,14 @@ class TemperatureSensor {
 
   private: /** Private Function */
 
+    float SteinhartHart(const int16_t adcReading);
+
+    #if ENABLED(THERMISTOR_LUT)
+      void CalcLut();
+      void AddLutPoint(const int16_t adcReading);
+      float LutTemperature(const int16_t adcReading);
+    #endif
+
 };
 
 #endif /* _SENSOR_H_ */
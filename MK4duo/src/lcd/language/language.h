@@ -89,6 +89,8 @@
 #define MSG_ERR_LINE_NO                     "Line Number is not Last Line Number+1, Last Line: "
 #define MSG_ERR_CHECKSUM_MISMATCH           "checksum mismatch, Last Line: "
 #define MSG_ERR_NO_CHECKSUM                 "No Checksum with line number, Last Line: "
+#define MSG_ERR_BINARY_FRAME                "Bad binary frame, Last Line: "
+#define MSG_ERR_BINARY_SAVING               "Binary command not written to file"
 #define MSG_FILE_PRINTED                    "Done printing file"
 #define MSG_STATS                           "Stats: "
 #define MSG_BEGIN_FILE_LIST                 "Begin file list"
@@ -170,24 +170,63 @@
       // If there's only 1 segment, loops will be skipped entirely.
       --segments;
 
-      // Calculate and execute the segments
-      for (uint16_t s = segments + 1; --s;) {
-        LOOP_XYZE(i) raw[i] += segment_distance[i];
-        Transform(raw);
-
-        // Adjust Z if bed leveling is enabled
-        #if ENABLED(AUTO_BED_LEVELING_BILINEAR)
-          if (bedlevel.leveling_active) {
-            const float zadj = abl.bilinear_z_offset(raw);
-            delta[A_AXIS] += zadj;
-            delta[B_AXIS] += zadj;
-            delta[C_AXIS] += zadj;
+      #if ENABLED(DELTA_BATCH_KINEMATICS)
+
+        // Calculate and execute the segments a batch at a time
+        float heights[DELTA_BATCH_SIZE][ABC];
+        while (segments) {
+          const uint8_t count = min(segments, (uint16_t)DELTA_BATCH_SIZE);
+          segments -= count;
+
+          {
+            CYCLE_PROBE(DELTA_KINEMATICS);
+            Transform_batch(raw, segment_distance, count, heights);
           }
-        #endif
 
-        planner.buffer_line(delta[A_AXIS], delta[B_AXIS], delta[C_AXIS], raw[E_AXIS], _feedrate_mm_s, tools.active_extruder);
+          for (uint8_t b = 0; b < count; b++) {
+            LOOP_XYZE(i) raw[i] += segment_distance[i];
+            COPY_ARRAY(delta, heights[b]);
+
+            // Adjust Z if bed leveling is enabled
+            #if ENABLED(AUTO_BED_LEVELING_BILINEAR)
+              if (bedlevel.leveling_active) {
+                const float zadj = abl.bilinear_z_offset(raw);
+                delta[A_AXIS] += zadj;
+                delta[B_AXIS] += zadj;
+                delta[C_AXIS] += zadj;
+              }
+            #endif
+
+            planner.buffer_line(delta[A_AXIS], delta[B_AXIS], delta[C_AXIS], raw[E_AXIS], _feedrate_mm_s, tools.active_extruder);
+          }
+        }
+
+      #else
 
-      }
+        // Calculate and execute the segments
+        for (uint16_t s = segments + 1; --s;) {
+          LOOP_XYZE(i) raw[i] += segment_distance[i];
+
+          {
+            CYCLE_PROBE(DELTA_KINEMATICS);
+            Transform(raw);
+          }
+
+          // Adjust Z if bed leveling is enabled
+          #if ENABLED(AUTO_BED_LEVELING_BILINEAR)
+            if (bedlevel.leveling_active) {
+              const float zadj = abl.bilinear_z_offset(raw);
+              delta[A_AXIS] += zadj;
+              delta[B_AXIS] += zadj;
+              delta[C_AXIS] += zadj;
+            }
+          #endif
+
+          planner.buffer_line(delta[A_AXIS], delta[B_AXIS], delta[C_AXIS], raw[E_AXIS], _feedrate_mm_s, tools.active_extruder);
+
+        }
+
+      #endif
 
       planner.buffer_line_kinematic(destination, _feedrate_mm_s, tools.active_extruder);
 
@@ -466,6 +505,64 @@
     planner._buffer_line(delta_A, delta_B, delta_C, re, fr, tools.active_extruder);
   }
 
+  #if ENABLED(DELTA_BATCH_KINEMATICS)
+
+    /**
+     * Delta Transform of a batch of segments
+     *
+     * Calculate the tower positions of the count points
+     * start + step, start + 2 * step, ... into heights[].
+     *
+     * The tower height above the effector is sqrt(q), where q is
+     * quadratic in the segment index, so q is stepped with forward
+     * differences. r = 1 / sqrt(q) is predicted from the previous
+     * segment and refined with one Newton step, which needs only
+     * multiplications. The first segment of each tower, and any
+     * segment whose prediction is not close enough, use the SQRT.
+     */
+    void Delta_Mechanics::Transform_batch(const float start[ABC], const float step[ABC], const uint8_t count, float heights[][ABC]) {
+
+      const float step_xy2 = HYPOT2(step[A_AXIS], step[B_AXIS]),
+                  ddq = -2.0f * step_xy2;
+
+      LOOP_XYZ(t) {
+        const float dx = towerX[t] - start[A_AXIS],
+                    dy = towerY[t] - start[B_AXIS];
+
+        float q   = delta_diagonal_rod_2[t] - HYPOT2(dx, dy),
+              dq  = 2.0f * (dx * step[A_AXIS] + dy * step[B_AXIS]) - step_xy2,
+              r   = 0.0,
+              dr  = 0.0;
+
+        for (uint8_t i = 0; i < count; i++) {
+          q += dq;
+          dq += ddq;
+
+          float h;
+          const float rp = r + dr,
+                      y  = q * rp * rp;   // 1 when rp is exact
+
+          if (i && FABS(1.0f - y) < 0.001f) {
+            const float rn = rp * (1.5f - 0.5f * y);
+            dr = rn - r;
+            r = rn;
+            h = q * r;
+          }
+          else {
+            h = _SQRT(q);
+            const float rn = 1.0f / h;
+            // Seed the prediction of the next segment with the slope of r
+            dr = i ? rn - r : -0.5f * rn * rn * rn * dq;
+            r = rn;
+          }
+
+          heights[i][t] = start[C_AXIS] + (i + 1) * step[C_AXIS] + h;
+        }
+      }
+    }
+
+  #endif // DELTA_BATCH_KINEMATICS
+
   void Delta_Mechanics::Set_clip_start_height() {
     float cartesian[ABC] = { 0, 0, 0 };
     Transform(cartesian);
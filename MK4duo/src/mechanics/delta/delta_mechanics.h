@@ -121,6 +121,9 @@
       void InverseTransform(const float point[ABC], float cartesian[ABC]) { InverseTransform(point[A_AXIS], point[B_AXIS], point[C_AXIS], cartesian); }
       void Transform(const float raw[ABC]);
       void Transform_segment_raw(const float rx, const float ry, const float rz, const float re, const float fr);
+      #if ENABLED(DELTA_BATCH_KINEMATICS)
+        void Transform_batch(const float start[ABC], const float step[ABC], const uint8_t count, float heights[][ABC]);
+      #endif
       void recalc_delta_settings();
 
       /**
@@ -50,6 +50,10 @@
     , "Select only one of: DELTA_AUTO_CALIBRATION_1 or DELTA_AUTO_CALIBRATION_2"
   );
 
+  #if ENABLED(DELTA_BATCH_KINEMATICS) && !WITHIN(DELTA_BATCH_SIZE, 2, 32)
+    #error "DELTA_BATCH_SIZE must be from 2 to 32."
+  #endif
+
   #if DISABLED(DELTA_DIAGONAL_ROD)
     #error DEPENDENCY ERROR: Missing setting DELTA_DIAGONAL_ROD
   #endif
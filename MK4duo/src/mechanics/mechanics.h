@@ -86,6 +86,10 @@ class Mechanics {
     uint32_t  max_acceleration_steps_per_s2[XYZE_N] = { 0 },
               max_acceleration_mm_per_s2[XYZE_N]    = { 0 };
 
+    #if ENABLED(JUNCTION_DEVIATION)
+      float   junction_deviation_mm                 = 0.0;
+    #endif
+
     const signed char home_dir[XYZ]       = { X_HOME_DIR, Y_HOME_DIR, Z_HOME_DIR };
 
     /**
@@ -276,6 +276,9 @@
 #if DISABLED(DEFAULT_ZJERK)
   #error DEPENDENCY ERROR: Missing setting DEFAULT_ZJERK
 #endif
+#if ENABLED(JUNCTION_DEVIATION) && DISABLED(JUNCTION_DEVIATION_MM)
+  #error DEPENDENCY ERROR: Missing setting JUNCTION_DEVIATION_MM
+#endif
 
 
 // Two or more Z steppers
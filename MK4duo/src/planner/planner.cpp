@@ -66,8 +66,10 @@ Planner planner;
  * A ring buffer of moves described in steps
  */
 block_t Planner::block_buffer[BLOCK_BUFFER_SIZE];
-volatile uint8_t  Planner::block_buffer_head = 0, // Index of the next block to be pushed
-                  Planner::block_buffer_tail = 0;
+volatile uint8_t  Planner::block_buffer_head    = 0, // Index of the next block to be pushed
+                  Planner::block_buffer_tail    = 0, // Index of the busy block, if any
+                  Planner::block_buffer_planned = 0, // Index of the optimally planned block
+                  Planner::block_buffer_nonbusy = 0; // Index of the next block for the step preparation
 
 #if HAS_TEMP_HOTEND && ENABLED(AUTOTEMP)
   float Planner::autotemp_max = 250,
@@ -83,8 +85,12 @@ uint32_t Planner::cutoff_long;
 float Planner::previous_speed[NUM_AXIS],
       Planner::previous_nominal_speed;
 
+#if ENABLED(JUNCTION_DEVIATION)
+  float Planner::previous_unit_vec[XYZ];
+#endif
+
 #if ENABLED(DISABLE_INACTIVE_EXTRUDER)
-  uint8_t Planner::g_uc_extruder_last_move[EXTRUDERS] = { 0 };
+  uint16_t Planner::g_uc_extruder_last_move[EXTRUDERS] = { 0 };
 #endif // DISABLE_INACTIVE_EXTRUDER
 
 #if ENABLED(XY_FREQUENCY_LIMIT)
@@ -105,13 +111,16 @@ float Planner::previous_speed[NUM_AXIS],
 #endif
 
 void Planner::init() {
-  block_buffer_head = block_buffer_tail = 0;
+  block_buffer_head = block_buffer_tail = block_buffer_planned = block_buffer_nonbusy = 0;
   ZERO(position);
   #if ENABLED(LIN_ADVANCE)
     ZERO(position_float);
   #endif
   ZERO(previous_speed);
   previous_nominal_speed = 0.0;
+  #if ENABLED(JUNCTION_DEVIATION)
+    ZERO(previous_unit_vec);
+  #endif
   #if ABL_PLANAR
     bedlevel.matrix.set_to_identity();
   #endif
@@ -146,6 +155,21 @@ void Planner::calculate_trapezoid_for_block(block_t* const block, const float &e
     plateau_steps = 0;
   }
 
+  #if ENABLED(S_CURVE_ACCELERATION)
+    // The S-curve is evaluated on time, not on steps. Its ramps take the same
+    // time and distance as the linear ones, from the rate reached at the end
+    // of the acceleration, the nominal rate if there is a plateau.
+    uint32_t cruise_rate = plateau_steps ? block->nominal_rate : (uint32_t)SQRT(sq((float)initial_rate) + 2.0 * accel * accelerate_steps);
+    NOLESS(cruise_rate, initial_rate);
+    NOLESS(cruise_rate, final_rate);
+    const float ticks_per_rate = accel ? (HAL_STEPPER_TIMER_RATE) / (float)accel : 0.0;
+    const uint32_t acceleration_time = (cruise_rate - initial_rate) * ticks_per_rate,
+                   deceleration_time = (cruise_rate - final_rate) * ticks_per_rate,
+                   // The ISR gets the time in the ramp by a multiplication
+                   acceleration_time_inverse = acceleration_time ? 0xFFFFFFFF / acceleration_time : 0xFFFFFFFF,
+                   deceleration_time_inverse = deceleration_time ? 0xFFFFFFFF / deceleration_time : 0xFFFFFFFF;
+  #endif
+
   // block->accelerate_until = accelerate_steps;
   // block->decelerate_after = accelerate_steps+plateau_steps;
 
@@ -155,6 +179,13 @@ void Planner::calculate_trapezoid_for_block(block_t* const block, const float &e
       block->decelerate_after = accelerate_steps + plateau_steps;
       block->initial_rate = initial_rate;
       block->final_rate = final_rate;
+      #if ENABLED(S_CURVE_ACCELERATION)
+        block->cruise_rate = cruise_rate;
+        block->acceleration_time = acceleration_time;
+        block->deceleration_time = deceleration_time;
+        block->acceleration_time_inverse = acceleration_time_inverse;
+        block->deceleration_time_inverse = deceleration_time_inverse;
+      #endif
     }
   CRITICAL_SECTION_END
 }
@@ -179,32 +210,38 @@ void Planner::reverse_pass_kernel(block_t* const current, const block_t *next) {
 /**
  * recalculate() needs to go over the current plan twice.
  * Once in reverse and once forward. This implements the reverse pass.
+ *
+ * Only the blocks after the optimally planned block can change,
+ * so the pass stops there instead of going back to the tail.
  */
 void Planner::reverse_pass() {
 
-  if (movesplanned() > 3) {
+  // The stepper ISR can advance block_buffer_planned, make a local copy
+  uint8_t planned = block_buffer_planned;
+  if (planned == block_buffer_head) return;
 
-    block_t* block[3] = { NULL, NULL, NULL };
+  // The entry speed of the last block was set when it was added
+  uint8_t b = prev_block_index(block_buffer_head);
+  const block_t *next = &block_buffer[b];
 
-    // Make a local copy of block_buffer_tail, because the interrupt can alter it
-    //CRITICAL_SECTION_START
-    uint8_t tail = block_buffer_tail;
-    //CRITICAL_SECTION_END
+  while (b != planned) {
+    b = prev_block_index(b);
 
-    uint8_t b = BLOCK_MOD(block_buffer_head - 3);
-    while (b != tail) {
-      if (block[0] && TEST(block[0]->flag, BLOCK_BIT_START_FROM_FULL_HALT)) break;
-      b = prev_block_index(b);
-      block[2] = block[1];
-      block[1] = block[0];
-      block[0] = &block_buffer[b];
-      reverse_pass_kernel(block[1], block[2]);
+    // Follow the ISR and never replan a block that is already busy
+    while (planned != block_buffer_planned) {
+      if (b == planned) return;
+      planned = next_block_index(planned);
     }
+    if (b == planned) break;
+
+    block_t* const current = &block_buffer[b];
+    reverse_pass_kernel(current, next);
+    next = current;
   }
 }
 
 // The kernel called by recalculate() when scanning the plan from first to last entry.
-void Planner::forward_pass_kernel(const block_t* previous, block_t* const current) {
+void Planner::forward_pass_kernel(const block_t* previous, block_t* const current, const uint8_t block_index) {
   if (!previous) return;
 
   // If the previous block is an mechanics.acceleration block, but it is not long enough to complete the
@@ -219,34 +256,46 @@ void Planner::forward_pass_kernel(const block_t* previous, block_t* const curren
       if (current->entry_speed != entry_speed) {
         current->entry_speed = entry_speed;
         SBI(current->flag, BLOCK_BIT_RECALCULATE);
+        // Full acceleration from an optimal block, the plan can't improve up to here
+        block_buffer_planned = block_index;
       }
     }
   }
+
+  // A block entered at its maximum speed can't improve either
+  if (current->entry_speed == current->max_entry_speed)
+    block_buffer_planned = block_index;
 }
 
 /**
  * recalculate() needs to go over the current plan twice.
  * Once in reverse and once forward. This implements the forward pass.
+ *
+ * It starts from the optimally planned block and moves it forward
+ * to the last block that no new block can change.
  */
 void Planner::forward_pass() {
-  block_t* block[3] = { NULL, NULL, NULL };
+  uint8_t b = block_buffer_planned;
+  if (b == block_buffer_head) return;
+
+  const block_t* previous = &block_buffer[b];
 
-  for (uint8_t b = block_buffer_tail; b != block_buffer_head; b = next_block_index(b)) {
-    block[0] = block[1];
-    block[1] = block[2];
-    block[2] = &block_buffer[b];
-    forward_pass_kernel(block[0], block[1]);
+  for (b = next_block_index(b); b != block_buffer_head; b = next_block_index(b)) {
+    block_t* const current = &block_buffer[b];
+    // If the previous block became busy its exit speed can't change anymore
+    if (!TEST(previous->flag, BLOCK_BIT_BUSY))
+      forward_pass_kernel(previous, current, b);
+    previous = current;
   }
-  forward_pass_kernel(block[1], block[2]);
 }
 
 /**
- * Recalculate the trapezoid speed profiles for all blocks in the plan
+ * Recalculate the trapezoid speed profiles for the blocks from first_index
  * according to the entry_factor for each junction. Must be called by
  * recalculate() after updating the blocks.
  */
-void Planner::recalculate_trapezoids() {
-  int8_t block_index = block_buffer_tail;
+void Planner::recalculate_trapezoids(const uint8_t first_index) {
+  uint8_t block_index = first_index;
   block_t *current, *next = NULL;
 
   while (block_index != block_buffer_head) {
@@ -294,11 +343,17 @@ void Planner::recalculate_trapezoids() {
  * jerk is jerkier than the set limit, Jerky. Finally it will:
  *
  *   3. Recalculate "trapezoids" for all blocks.
+ *
+ * Blocks up to block_buffer_planned already have the best possible entry
+ * speed and a new block can't change them, so only the blocks after it
+ * are replanned. The work done per block stays small with a big buffer.
  */
 void Planner::recalculate() {
+  // The block before the planned one may still need its trapezoid
+  const uint8_t first_index = block_buffer_planned;
   reverse_pass();
   forward_pass();
-  recalculate_trapezoids();
+  recalculate_trapezoids(first_index);
 }
 
 
@@ -409,6 +464,8 @@ void Planner::check_axes_activity() {
  */
 void Planner::_buffer_line(const float &a, const float &b, const float &c, const float &e, float fr_mm_s, const uint8_t extruder) {
 
+  CYCLE_PROBE(BUFFER_LINE);
+
   // The target position of the tool in absolute steps
   // Calculate target position in absolute steps
   // this should be done after the wait, because otherwise a M92 code within the gcode disrupts this calculation somehow
@@ -525,11 +582,14 @@ void Planner::_buffer_line(const float &a, const float &b, const float &c, const
   const int32_t esteps = abs(esteps_float) + 0.5;
 
   // Calculate the buffer head after we push this byte
-  const int8_t next_buffer_head = next_block_index(block_buffer_head);
+  const uint8_t next_buffer_head = next_block_index(block_buffer_head);
 
   // If the buffer is full: good! That means we are well ahead of the robot.
   // Rest here until there is room in the buffer.
+  // The wait is not planner work, leave it out of the profile.
+  CYCLE_PROBE_PAUSE(BUFFER_LINE);
   while (block_buffer_tail == next_buffer_head) printer.idle();
+  CYCLE_PROBE_RESUME(BUFFER_LINE);
 
   // Prepare to set up new block
   block_t* block = &block_buffer[block_buffer_head];
@@ -1067,54 +1127,85 @@ void Planner::_buffer_line(const float &a, const float &b, const float &c, const
   // Initial limit on the segment entry velocity
   float vmax_junction;
 
-  #if 0  // Use old jerk for now
-
-    float junction_deviation = 0.1;
-
-    // Compute path unit vector
-    double unit_vec[XYZ] = {
-      delta_mm[X_AXIS] * inverse_millimeters,
-      delta_mm[Y_AXIS] * inverse_millimeters,
-      delta_mm[Z_AXIS] * inverse_millimeters
-    };
-
-    /*
-       Compute maximum allowable entry speed at junction by centripetal mechanics.acceleration approximation.
-
-       Let a circle be tangent to both previous and current path line segments, where the junction
-       deviation is defined as the distance from the junction to the closest edge of the circle,
-       collinear with the circle center.
-
-       The circular segment joining the two paths represents the path of centripetal mechanics.acceleration.
-       Solve for max velocity based on max mechanics.acceleration about the radius of the circle, defined
-       indirectly by junction deviation.
-
-       This may be also viewed as path width or max_jerk in the previous grbl version. This approach
-       does not actually deviate from path, but used as a robust way to compute cornering speeds, as
-       it takes into account the nonlinearities of both the junction angle and junction velocity.
+  #if ENABLED(JUNCTION_DEVIATION)
+
+    /**
+     * Compute maximum allowable entry speed at junction by centripetal mechanics.acceleration approximation.
+     *
+     * Let a circle be tangent to both previous and current path line segments, where the junction
+     * deviation is defined as the distance from the junction to the closest edge of the circle,
+     * collinear with the circle center.
+     *
+     * The circular segment joining the two paths represents the path of centripetal mechanics.acceleration.
+     * Solve for max velocity based on max mechanics.acceleration about the radius of the circle, defined
+     * indirectly by junction deviation.
+     *
+     * This approach does not actually deviate from path, but used as a robust way to compute cornering
+     * speeds, as it takes into account the nonlinearities of both the junction angle and junction velocity.
+     *
+     * E only moves have no direction, their junctions are limited by jerk.
      */
 
-    vmax_junction = MINIMUM_PLANNER_SPEED; // Set default max junction speed
-
-    // Skip first block or when previous_nominal_speed is used as a flag for homing and offset cycles.
-    if (block_buffer_head != block_buffer_tail && previous_nominal_speed > 0.0) {
-      // Compute cosine of angle between previous and current path. (prev_unit_vec is negative)
-      // NOTE: Max junction velocity is computed without sin() or acos() by trig half angle identity.
-      float cos_theta = - previous_unit_vec[X_AXIS] * unit_vec[X_AXIS]
-                        - previous_unit_vec[Y_AXIS] * unit_vec[Y_AXIS]
-                        - previous_unit_vec[Z_AXIS] * unit_vec[Z_AXIS];
-      // Skip and use default max junction speed for 0 degree acute junction.
-      if (cos_theta < 0.95) {
-        vmax_junction = min(previous_nominal_speed, block->nominal_speed);
-        // Skip and avoid divide by zero for straight junctions at 180 degrees. Limit to min() of nominal speeds.
-        if (cos_theta > -0.95) {
-          // Compute maximum junction velocity based on maximum mechanics.acceleration and junction deviation
-          float sin_theta_d2 = SQRT(0.5 * (1.0 - cos_theta)); // Trig half angle identity. Always positive.
-          NOMORE(vmax_junction, SQRT(block->acceleration * junction_deviation * sin_theta_d2 / (1.0 - sin_theta_d2)));
+    // Path unit vector of the head, zero for E only moves
+    float unit_vec[XYZ] = { 0.0 };
+    if (block->steps[X_AXIS] >= MIN_STEPS_PER_SEGMENT || block->steps[Y_AXIS] >= MIN_STEPS_PER_SEGMENT || block->steps[Z_AXIS] >= MIN_STEPS_PER_SEGMENT) {
+      #if CORE_IS_XY
+        unit_vec[X_AXIS] = delta_mm[X_HEAD];
+        unit_vec[Y_AXIS] = delta_mm[Y_HEAD];
+        unit_vec[Z_AXIS] = delta_mm[Z_AXIS];
+      #elif CORE_IS_XZ
+        unit_vec[X_AXIS] = delta_mm[X_HEAD];
+        unit_vec[Y_AXIS] = delta_mm[Y_AXIS];
+        unit_vec[Z_AXIS] = delta_mm[Z_HEAD];
+      #elif CORE_IS_YZ
+        unit_vec[X_AXIS] = delta_mm[X_AXIS];
+        unit_vec[Y_AXIS] = delta_mm[Y_HEAD];
+        unit_vec[Z_AXIS] = delta_mm[Z_HEAD];
+      #else
+        unit_vec[X_AXIS] = delta_mm[X_AXIS];
+        unit_vec[Y_AXIS] = delta_mm[Y_AXIS];
+        unit_vec[Z_AXIS] = delta_mm[Z_AXIS];
+      #endif
+      LOOP_XYZ(i) unit_vec[i] *= inverse_millimeters;
+    }
+
+    // Cosine of the junction angle: -1 when the path goes straight on, 1 on a full reversal.
+    // NOTE: Max junction velocity is computed without sin() or acos() by trig half angle identity.
+    float cos_theta = - previous_unit_vec[X_AXIS] * unit_vec[X_AXIS]
+                      - previous_unit_vec[Y_AXIS] * unit_vec[Y_AXIS]
+                      - previous_unit_vec[Z_AXIS] * unit_vec[Z_AXIS];
+
+    // Junction deviation is off with M205 J0, or on the first block,
+    // or when previous_nominal_speed is used as a flag for homing and offset cycles.
+    const bool junction_deviation = mechanics.junction_deviation_mm > 0.0
+                                    && moves_queued > 1 && previous_nominal_speed > 0.0001
+                                    && (previous_unit_vec[X_AXIS] || previous_unit_vec[Y_AXIS] || previous_unit_vec[Z_AXIS])
+                                    && (unit_vec[X_AXIS] || unit_vec[Y_AXIS] || unit_vec[Z_AXIS]);
+
+    if (junction_deviation) {
+      if (cos_theta > 0.999999) {
+        // Full reversal, stop at the junction
+        vmax_junction = MINIMUM_PLANNER_SPEED;
+      }
+      else {
+        NOLESS(cos_theta, -0.999999);
+        const float sin_theta_d2 = SQRT(0.5 * (1.0 - cos_theta)); // Trig half angle identity. Always positive.
+        vmax_junction = SQRT(block->acceleration * mechanics.junction_deviation_mm * sin_theta_d2 / (1.0 - sin_theta_d2));
+
+        // Short segments are usually a curve. Also limit the centripetal acceleration on the arc
+        // through the segments, its radius is millimeters / turn angle. For the small angles of a
+        // curve the turn angle is about 2 * sin(turn angle / 2) = 2 * cos(theta / 2).
+        if (block->millimeters < 1.0) {
+          const float turn = 2.0 * SQRT(0.5 * (1.0 + cos_theta));
+          if (turn > 0.0) NOMORE(vmax_junction, SQRT(block->acceleration * block->millimeters / turn));
         }
+
+        // Never more than the nominal speeds
+        NOMORE(vmax_junction, min(previous_nominal_speed, block->nominal_speed));
       }
     }
-  #endif
+
+  #endif // JUNCTION_DEVIATION
 
   /**
    * Start with a safe speed (from which the machine may halt to stop immediately).
@@ -1141,57 +1232,65 @@ void Planner::_buffer_line(const float &a, const float &b, const float &c, const
     }
   }
 
-  if (moves_queued > 1 && previous_nominal_speed > 0.0001) {
-    // Estimate a maximum velocity allowed at a joint of two successive segments.
-    // If this maximum velocity allowed is lower than the minimum of the entry / exit safe velocities,
-    // then the machine is not coasting anymore and the safe entry / exit velocities shall be used.
-
-    // The junction velocity will be shared between successive segments. Limit the junction velocity to their minimum.
-    bool prev_speed_larger = previous_nominal_speed > block->nominal_speed;
-    float smaller_speed_factor = prev_speed_larger ? (block->nominal_speed / previous_nominal_speed) : (previous_nominal_speed / block->nominal_speed);
-    // Pick the smaller of the nominal speeds. Higher speed shall not be achieved at the junction during coasting.
-    vmax_junction = prev_speed_larger ? block->nominal_speed : previous_nominal_speed;
-    // Factor to multiply the previous / current nominal velocities to get componentwise limited velocities.
-    float v_factor = 1.f;
-    limited = 0;
-    // Now limit the jerk in all axes.
-    LOOP_XYZE(axis) {
-      // Limit an axis. We have to differentiate: coasting, reversal of an axis, full stop.
-      float v_exit = previous_speed[axis], v_entry = current_speed[axis];
-      const float maxj = (axis == E_AXIS) ? mechanics.max_jerk[axis + extruder] : mechanics.max_jerk[axis];
-
-      if (prev_speed_larger) v_exit *= smaller_speed_factor;
-      if (limited) {
-        v_exit *= v_factor;
-        v_entry *= v_factor;
+  // With junction deviation the corner speed is already known, else limit it by jerk
+  #if ENABLED(JUNCTION_DEVIATION)
+    const bool use_jerk = !junction_deviation;
+  #else
+    constexpr bool use_jerk = true;
+  #endif
+  if (use_jerk) {
+    if (moves_queued > 1 && previous_nominal_speed > 0.0001) {
+      // Estimate a maximum velocity allowed at a joint of two successive segments.
+      // If this maximum velocity allowed is lower than the minimum of the entry / exit safe velocities,
+      // then the machine is not coasting anymore and the safe entry / exit velocities shall be used.
+
+      // The junction velocity will be shared between successive segments. Limit the junction velocity to their minimum.
+      bool prev_speed_larger = previous_nominal_speed > block->nominal_speed;
+      float smaller_speed_factor = prev_speed_larger ? (block->nominal_speed / previous_nominal_speed) : (previous_nominal_speed / block->nominal_speed);
+      // Pick the smaller of the nominal speeds. Higher speed shall not be achieved at the junction during coasting.
+      vmax_junction = prev_speed_larger ? block->nominal_speed : previous_nominal_speed;
+      // Factor to multiply the previous / current nominal velocities to get componentwise limited velocities.
+      float v_factor = 1.f;
+      limited = 0;
+      // Now limit the jerk in all axes.
+      LOOP_XYZE(axis) {
+        // Limit an axis. We have to differentiate: coasting, reversal of an axis, full stop.
+        float v_exit = previous_speed[axis], v_entry = current_speed[axis];
+        const float maxj = (axis == E_AXIS) ? mechanics.max_jerk[axis + extruder] : mechanics.max_jerk[axis];
+
+        if (prev_speed_larger) v_exit *= smaller_speed_factor;
+        if (limited) {
+          v_exit *= v_factor;
+          v_entry *= v_factor;
+        }
+        // Calculate jerk depending on whether the axis is coasting in the same direction or reversing.
+        const float jerk = (v_exit > v_entry)
+            ? //                                  coasting             axis reversal
+              ( (v_entry > 0.f || v_exit < 0.f) ? (v_exit - v_entry) : max(v_exit, -v_entry) )
+            : // v_exit <= v_entry                coasting             axis reversal
+              ( (v_entry < 0.f || v_exit > 0.f) ? (v_entry - v_exit) : max(-v_exit, v_entry) );
+
+        if (jerk > maxj) {
+          v_factor *= maxj / jerk;
+          ++limited;
+        }
       }
-      // Calculate jerk depending on whether the axis is coasting in the same direction or reversing.
-      const float jerk = (v_exit > v_entry)
-          ? //                                  coasting             axis reversal
-            ( (v_entry > 0.f || v_exit < 0.f) ? (v_exit - v_entry) : max(v_exit, -v_entry) )
-          : // v_exit <= v_entry                coasting             axis reversal
-            ( (v_entry < 0.f || v_exit > 0.f) ? (v_entry - v_exit) : max(-v_exit, v_entry) );
-
-      if (jerk > maxj) {
-        v_factor *= maxj / jerk;
-        ++limited;
+      if (limited) vmax_junction *= v_factor;
+      // Now the transition velocity is known, which maximizes the shared exit / entry velocity while
+      // respecting the jerk factors, it may be possible, that applying separate safe exit / entry velocities will achieve faster prints.
+      const float vmax_junction_threshold = vmax_junction * 0.99f;
+      if (previous_safe_speed > vmax_junction_threshold && safe_speed > vmax_junction_threshold) {
+        // Not coasting. The machine will stop and start the movements anyway,
+        // better to start the segment from start.
+        SBI(block->flag, BLOCK_BIT_START_FROM_FULL_HALT);
+        vmax_junction = safe_speed;
       }
     }
-    if (limited) vmax_junction *= v_factor;
-    // Now the transition velocity is known, which maximizes the shared exit / entry velocity while
-    // respecting the jerk factors, it may be possible, that applying separate safe exit / entry velocities will achieve faster prints.
-    const float vmax_junction_threshold = vmax_junction * 0.99f;
-    if (previous_safe_speed > vmax_junction_threshold && safe_speed > vmax_junction_threshold) {
-      // Not coasting. The machine will stop and start the movements anyway,
-      // better to start the segment from start.
+    else {
       SBI(block->flag, BLOCK_BIT_START_FROM_FULL_HALT);
       vmax_junction = safe_speed;
     }
   }
-  else {
-    SBI(block->flag, BLOCK_BIT_START_FROM_FULL_HALT);
-    vmax_junction = safe_speed;
-  }
 
   // Max entry speed of this block equals the max exit speed of the previous block.
   block->max_entry_speed = vmax_junction;
@@ -1212,6 +1311,9 @@ void Planner::_buffer_line(const float &a, const float &b, const float &c, const
 
   // Update previous path unit_vector and nominal speed
   COPY_ARRAY(previous_speed, current_speed);
+  #if ENABLED(JUNCTION_DEVIATION)
+    COPY_ARRAY(previous_unit_vec, unit_vec);
+  #endif
   previous_nominal_speed = block->nominal_speed;
   previous_safe_speed = safe_speed;
 
@@ -1252,6 +1354,10 @@ void Planner::_buffer_line(const float &a, const float &b, const float &c, const
   // Move buffer head
   block_buffer_head = next_buffer_head;
 
+  #if ENABLED(MOTION_STATS)
+    motionstats.block_queued();
+  #endif
+
   // Update the position (only when a move was queued)
   COPY_ARRAY(position, target);
   #if ENABLED(LIN_ADVANCE)
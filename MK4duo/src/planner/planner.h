@@ -104,6 +104,14 @@ typedef struct {
            final_rate,                          // The minimal rate at exit
            acceleration_steps_per_s2;           // acceleration steps/sec^2
 
+  #if ENABLED(S_CURVE_ACCELERATION)
+    uint32_t cruise_rate,                       // The rate reached at the end of the acceleration
+             acceleration_time,                 // Time of the acceleration in timer ticks
+             deceleration_time,                 // Time of the deceleration in timer ticks
+             acceleration_time_inverse,         // 0xFFFFFFFF / acceleration_time
+             deceleration_time_inverse;         // 0xFFFFFFFF / deceleration_time
+  #endif
+
   #if ENABLED(BARICUDA)
     uint32_t valve_pressure, e_to_p_pressure;
   #endif
@@ -145,8 +153,10 @@ class Planner {
      * A ring buffer of moves described in steps
      */
     static block_t block_buffer[BLOCK_BUFFER_SIZE];
-    static volatile uint8_t block_buffer_head,  // Index of the next block to be pushed
-                            block_buffer_tail;
+    static volatile uint8_t block_buffer_head,    // Index of the next block to be pushed
+                            block_buffer_tail,    // Index of the busy block, if any
+                            block_buffer_planned, // Index of the optimally planned block
+                            block_buffer_nonbusy; // Index of the next block for the step preparation
 
     /**
      * Limit where 64bit math is necessary for acceleration calculation
@@ -169,11 +179,18 @@ class Planner {
      */
     static float previous_nominal_speed;
 
+    #if ENABLED(JUNCTION_DEVIATION)
+      /**
+       * Unit vector of previous path line segment
+       */
+      static float previous_unit_vec[XYZ];
+    #endif
+
     #if ENABLED(DISABLE_INACTIVE_EXTRUDER)
       /**
        * Counters to manage disabling inactive extruders
        */
-      static uint8_t g_uc_extruder_last_move[EXTRUDERS];
+      static uint16_t g_uc_extruder_last_move[EXTRUDERS];
     #endif // DISABLE_INACTIVE_EXTRUDER
 
     #if ENABLED(XY_FREQUENCY_LIMIT)
@@ -265,26 +282,38 @@ class Planner {
      * Called when the current block is no longer needed.
      */
     static void discard_current_block() {
-      if (blocks_queued())
+      if (blocks_queued()) {
+        // Don't leave the planned block behind
+        if (block_buffer_planned == block_buffer_tail)
+          block_buffer_planned = BLOCK_MOD(block_buffer_tail + 1);
+        if (block_buffer_nonbusy == block_buffer_tail)
+          block_buffer_nonbusy = BLOCK_MOD(block_buffer_tail + 1);
         block_buffer_tail = BLOCK_MOD(block_buffer_tail + 1);
+      }
     }
 
     /**
-     * The current block. NULL if the buffer is empty.
-     * This also marks the block as busy.
+     * The first block not yet taken by the step preparation, while the
+     * blocks before it are still being stepped.
+     * NULL if there is none. This also marks the block as busy.
      */
-    static block_t* get_current_block() {
-      if (blocks_queued()) {
-        block_t* block = &block_buffer[block_buffer_tail];
+    static block_t* get_next_block() {
+      const uint8_t index = block_buffer_nonbusy;
+      if (index != block_buffer_head) {
+        block_t* block = &block_buffer[index];
         #if ENABLED(ULTRA_LCD)
           block_buffer_runtime_us -= block->segment_time_us; // We can't be sure how long an active block will take, so don't count it.
         #endif
         SBI(block->flag, BLOCK_BIT_BUSY);
+        // A busy block can't be replanned, so the plan starts after it
+        if (block_buffer_planned == index)
+          block_buffer_planned = next_block_index(index);
+        block_buffer_nonbusy = next_block_index(index);
         return block;
       }
       else {
         #if ENABLED(ULTRA_LCD)
-          clear_block_buffer_runtime(); // paranoia. Buffer is empty now - so reset accumulated time to zero.
+          if (!blocks_queued()) clear_block_buffer_runtime(); // paranoia. Buffer is empty now - so reset accumulated time to zero.
         #endif
         return NULL;
       }
@@ -325,8 +354,8 @@ class Planner {
     /**
      * Get the index of the next / previous block in the ring buffer
      */
-    static int8_t next_block_index(int8_t block_index) { return BLOCK_MOD(block_index + 1); }
-    static int8_t prev_block_index(int8_t block_index) { return BLOCK_MOD(block_index - 1); }
+    static uint8_t next_block_index(const uint8_t block_index) { return BLOCK_MOD(block_index + 1); }
+    static uint8_t prev_block_index(const uint8_t block_index) { return BLOCK_MOD(block_index - 1); }
 
     /**
      * Calculate the distance (not time) it takes to accelerate
@@ -362,12 +391,12 @@ class Planner {
     static void calculate_trapezoid_for_block(block_t* const block, const float &entry_factor, const float &exit_factor);
 
     static void reverse_pass_kernel(block_t* const current, const block_t *next);
-    static void forward_pass_kernel(const block_t *previous, block_t* const current);
+    static void forward_pass_kernel(const block_t *previous, block_t* const current, const uint8_t block_index);
 
     static void reverse_pass();
     static void forward_pass();
 
-    static void recalculate_trapezoids();
+    static void recalculate_trapezoids(const uint8_t first_index);
 
     static void recalculate();
 
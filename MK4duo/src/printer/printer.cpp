@@ -141,6 +141,10 @@ void Printer::setup() {
 
   HAL::hwSetup();
 
+  #if ENABLED(CYCLE_PROFILER)
+    cycleprofiler.init();
+  #endif
+
   #if HAS_FIL_RUNOUT
     filamentrunout.Init();
   #endif
@@ -176,9 +180,6 @@ void Printer::setup() {
   SERIAL_SMV(ECHO, MSG_FREE_MEMORY, HAL::getFreeRam());
   SERIAL_EMV(MSG_PLANNER_BUFFER_BYTES, (int)sizeof(block_t)*BLOCK_BUFFER_SIZE);
 
-  // Send "ok" after commands by default
-  commands.reset_send_ok();
-
   #if MECH(MUVE3D) && ENABLED(PROJECTOR_PORT) && ENABLED(PROJECTOR_BAUDRATE)
     DLPSerial.begin(PROJECTOR_BAUDRATE);
   #endif
@@ -359,6 +360,10 @@ void Printer::loop() {
     card.checkautostart(false);
   #endif
 
+  #if ENABLED(SD_GCODE_INFO_CACHE)
+    card.gcode_info_spin();
+  #endif
+
   commands.advance_command_queue();
 
   endstops.report_state();
@@ -370,6 +375,9 @@ void Printer::safe_delay(millis_t ms) {
     ms -= 50;
     HAL::delayMilliseconds(50);
     thermalManager.spin();
+    #if ENABLED(HEATER_CONTROL_SCHEDULER)
+      thermalManager.control();
+    #endif
   }
   HAL::delayMilliseconds(ms);
 }
@@ -500,6 +508,8 @@ void Printer::Stop() {
 
 void Printer::idle(bool no_stepper_sleep/*=false*/) {
 
+  CYCLE_PROBE(IDLE);
+
   static uint8_t cycle_1500ms = 15;
 
   // Start event periodical
@@ -536,6 +546,10 @@ void Printer::idle(bool no_stepper_sleep/*=false*/) {
     LOOP_FAN() fans[f].Check();
   #endif
 
+  #if ENABLED(HEATER_CONTROL_SCHEDULER)
+    thermalManager.control();
+  #endif
+
   if (HAL::execute_100ms) {
     // Event 100 Ms
     HAL::execute_100ms = false;
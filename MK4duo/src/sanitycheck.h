@@ -146,6 +146,8 @@
 // Buffer
 #if DISABLED(BLOCK_BUFFER_SIZE)
   #error DEPENDENCY ERROR: Missing setting BLOCK_BUFFER_SIZE
+#elif (BLOCK_BUFFER_SIZE & (BLOCK_BUFFER_SIZE - 1)) || BLOCK_BUFFER_SIZE < 2 || BLOCK_BUFFER_SIZE > 128
+  #error DEPENDENCY ERROR: BLOCK_BUFFER_SIZE must be a power of 2 from 2 to 128
 #endif
 #if DISABLED(MAX_CMD_SIZE)
   #error DEPENDENCY ERROR: Missing setting MAX_CMD_SIZE
@@ -162,5 +164,16 @@
 #if DISABLED(SDSUPPORT) && ENABLED(SERIAL_STATS_DROPPED_RX)
   #error DEPENDENCY ERROR: You must enable SDSUPPORT for SERIAL_STATS_DROPPED_RX
 #endif
+#if MAX_CMD_SIZE < 64 || MAX_CMD_SIZE % 4
+  #error DEPENDENCY ERROR: MAX_CMD_SIZE must be a multiple of 4 and 64 or more
+#endif
+#if BUFSIZE < 2
+  #error DEPENDENCY ERROR: BUFSIZE must be 2 or more
+#endif
+
+// Binary command stream
+#if ENABLED(BINARY_PROTOCOL) && ENABLED(EMERGENCY_PARSER)
+  #error CONFLICT ERROR: BINARY_PROTOCOL and EMERGENCY_PARSER are incompatible.
+#endif
 
 #endif /* _SANITYCHECK_H_ */
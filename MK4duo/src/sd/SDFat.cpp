@@ -522,6 +522,54 @@ bool SdBaseFile::createContiguous(SdBaseFile* dirFile,
 
   return sync();
 
+FAIL:
+  return false;
+}
+//------------------------------------------------------------------------------
+/** Add contiguous clusters to the end of a file opened for write.
+ *
+ * The clusters are linked to the cluster chain but the file size is not
+ * changed, so the following writes use them without searching the FAT.
+ * Call truncate() with the file size to free the clusters not used.
+ *
+ * \param[in] count Number of clusters to add.
+ *
+ * \return The value one, true, is returned for success and
+ * the value zero, false, is returned for failure.
+ * Reasons for failure include file is read only, file is a directory,
+ * no group of \a count free clusters or an I/O error occurs.
+ */
+bool SdBaseFile::preAllocate(uint32_t count) {
+  uint32_t last, next;
+  // error if not a normal file or read-only
+  if (!isFile() || !(flags_ & O_WRITE) || count == 0) {
+    DBG_FAIL_MACRO;
+    goto FAIL;
+  }
+  // find the end of the cluster chain
+  last = curCluster_ ? curCluster_ : firstCluster_;
+  if (last) {
+    for (;;) {
+      if (!vol_->fatGet(last, &next)) {
+        DBG_FAIL_MACRO;
+        goto FAIL;
+      }
+      if (vol_->isEOC(next)) break;
+      last = next;
+    }
+  }
+  // allocate and link clusters
+  if (!vol_->allocContiguous(count, &last)) {
+    DBG_FAIL_MACRO;
+    goto FAIL;
+  }
+  // if first cluster of file link to directory entry
+  if (firstCluster_ == 0) {
+    firstCluster_ = last;
+    flags_ |= F_FILE_DIR_DIRTY;
+  }
+  return true;
+
 FAIL:
   return false;
 }
@@ -2675,8 +2723,8 @@ bool SdBaseFile::truncate(uint32_t length) {
     DBG_FAIL_MACRO;
     goto FAIL;
   }
-  // fileSize and length are zero - nothing to do
-  if (fileSize_ == 0) return true;
+  // fileSize and length are zero and no cluster preallocated - nothing to do
+  if (fileSize_ == 0 && firstCluster_ == 0) return true;
 
   // remember position for seek after truncation
   newPos = curPosition_ > length ? length : curPosition_;
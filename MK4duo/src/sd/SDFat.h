@@ -349,7 +349,7 @@
    * for FAT table entries.  Improves performance for large writes that
    * are not a multiple of 512 bytes.
    */
-  #ifdef __arm__
+  #if defined(__arm__) || ENABLED(SD_SEPARATE_FAT_CACHE)
     #define USE_SEPARATE_FAT_CACHE 1
   #else  // __arm__
     #define USE_SEPARATE_FAT_CACHE 0
@@ -1810,6 +1810,7 @@
      */
     uint8_t type() const {return type_;}
     bool truncate(uint32_t size);
+    bool preAllocate(uint32_t count);
     /** \return SdVolume that contains this file. */
     SdVolume* volume() const {return vol_;}
     int write(const void* buf, size_t nbyte);
@@ -107,6 +107,10 @@
     cardOK = false;
     if (root.isOpen()) root.close();
 
+    #if ENABLED(SD_GCODE_INFO_CACHE)
+      gcode_info_clear();
+    #endif
+
     #if ENABLED(SDEXTRASLOW)
       #define SPI_SPEED SPI_QUARTER_SPEED
     #elif ENABLED(SDSLOW)
@@ -138,6 +142,9 @@
   void CardReader::unmount() {
     cardOK = false;
     sdprinting = false;
+    #if ENABLED(SD_GCODE_INFO_CACHE)
+      gcode_info_clear();
+    #endif
   }
 
   void CardReader::startFileprint() {
@@ -190,12 +197,59 @@
     end[1] = '\r';
     end[2] = '\n';
     end[3] = '\0';
-    gcode_file.write(begin);
-    if (gcode_file.writeError) {
-      SERIAL_LM(ER, MSG_SD_ERR_WRITE_TO_FILE);
-    }
+    #if ENABLED(SD_WRITE_BEHIND)
+      for (uint16_t len = strlen(begin); len;) {
+        const uint16_t n = min(len, uint16_t(SD_WRITE_BEHIND_SIZE - write_len));
+        memcpy(write_buffer + write_len, begin, n);
+        write_len += n;
+        begin += n;
+        len -= n;
+        if (write_len == SD_WRITE_BEHIND_SIZE && !flush_write_buffer()) {
+          SERIAL_LM(ER, MSG_SD_ERR_WRITE_TO_FILE);
+          return;
+        }
+      }
+    #else
+      gcode_file.write(begin);
+      if (gcode_file.writeError) {
+        SERIAL_LM(ER, MSG_SD_ERR_WRITE_TO_FILE);
+      }
+    #endif
   }
 
+  #if ENABLED(SD_WRITE_BEHIND)
+
+    /**
+     * Write the buffered upload to the file.
+     * The file is written from its start a full buffer at a time, so all the
+     * writes but the last are whole blocks that SdFat sends straight to the card
+     * (multi-block when the buffer holds two or more blocks), leaving the block
+     * cache to the FAT and directory. With SD_WRITE_PREALLOCATE the clusters are
+     * added in contiguous groups before they are needed, instead of one FAT
+     * search and update every cluster.
+     */
+    bool CardReader::flush_write_buffer() {
+      if (!write_len) return true;
+
+      #if SD_WRITE_PREALLOCATE > 0
+        const uint32_t need = gcode_file.fileSize() + write_len;
+        if (need > write_alloc) {
+          const uint32_t cluster_size = (uint32_t)gcode_file.volume()->blocksPerCluster() << 9,
+                         count = (max(need - write_alloc, (uint32_t)SD_WRITE_PREALLOCATE) + cluster_size - 1) / cluster_size;
+          if (gcode_file.preAllocate(count))
+            write_alloc += count * cluster_size;
+          else
+            write_alloc = 0xFFFFFFFF; // No room for a group, let SdFat add the clusters one at a time
+        }
+      #endif
+
+      const bool ok = gcode_file.write(write_buffer, write_len) == write_len;
+      write_len = 0;
+      return ok;
+    }
+
+  #endif // SD_WRITE_BEHIND
+
   #if HAS_EEPROM_SD
 
     bool CardReader::write_data(SdFile *currentfile, const uint8_t value) {
@@ -225,6 +279,9 @@
 
       fileSize = gcode_file.fileSize();
       sdpos = 0;
+      #if ENABLED(SD_READ_AHEAD)
+        read_len = read_pos = 0;
+      #endif
 
       SERIAL_MT(MSG_SD_FILE_OPENED, oldP);
       SERIAL_EMV(MSG_SD_SIZE, fileSize);
@@ -234,7 +291,9 @@
         const_cast<char&>(fileName[c]) = '\0';
       strncpy(fileName, filename, strlen(filename));
 
-      #if ENABLED(JSON_OUTPUT)
+      #if ENABLED(SD_GCODE_INFO_CACHE)
+        gcode_info_select(filename);
+      #elif ENABLED(JSON_OUTPUT)
         parsejson(gcode_file);
       #endif
 
@@ -246,6 +305,174 @@
     }
   }
 
+  #if ENABLED(SD_READ_AHEAD)
+
+    /**
+     * Refill the read ahead buffer.
+     * After a seek the first read stops at the block boundary, then the reads
+     * are whole blocks that SdFat transfers straight into the buffer
+     * (multi-block when the buffer holds two or more blocks), bypassing the
+     * single block cache.
+     */
+    bool CardReader::fill_read_buffer() {
+      const int16_t len = gcode_file.read(read_buffer, SD_READ_AHEAD_SIZE - (gcode_file.curPosition() & 0x1FF));
+      read_pos = 0;
+      read_len = len > 0 ? len : 0;
+      return read_len > 0;
+    }
+
+  #endif // SD_READ_AHEAD
+
+  #if ENABLED(ABL_PRINT_AREA_PROBING)
+
+    /**
+     * XY bounding box of the print, for G29 to probe only the grid under it.
+     * The ";MINX:" ";MINY:" ";MAXX:" ";MAXY:" header of Cura is used when
+     * present, otherwise the extruding moves of the first layer after the last
+     * G29 of the file. Start G-code before G29 doesn't count, a purge line
+     * after it does. The file position of the print is not changed.
+     */
+    bool CardReader::scan_print_area(float min[2], float max[2]) {
+
+      enum ScanWord : int8_t { SW_X, SW_Y, SW_Z, SW_E, SW_I, SW_J, SW_G, SW_M, SW_NONE, SW_COMMENT };
+
+      const uint32_t resume = gcode_file.curPosition();
+      if (!gcode_file.seekSet(0)) return false;
+
+      float   pos[XYZE] = { NAN, NAN, NAN, 0.0 },
+              val[SW_NONE],
+              area[4] = { 99999.0, 99999.0, -99999.0, -99999.0 },
+              head[4],
+              layer_z = 99999.0;
+      bool    relative = false,
+              relative_e = printer.axis_relative_modes[E_AXIS],
+              done = false;
+      int8_t  word = SW_NONE;
+      uint8_t seen = 0, head_found = 0, n = 0, chunks = 0;
+      char    text[16];
+      uint8_t buf[128];
+
+      while (!done) {
+        int16_t len = gcode_file.read(buf, sizeof(buf));
+        if (len <= 0) { buf[0] = '\n'; len = 1; done = true; } // End the last line
+
+        for (int16_t b = 0; b < len; b++) {
+          const char c = buf[b];
+          const bool eol = c == '\n' || c == '\r';
+
+          if (word == SW_COMMENT) {
+            if (!eol) {
+              if (n < sizeof(text) - 1) text[n++] = c;
+              continue;
+            }
+            // Cura header, MINX:, MINY:, MAXX: and MAXY:
+            text[n] = '\0';
+            if (n > 5 && text[0] == 'M' && text[4] == ':' && (text[3] == 'X' || text[3] == 'Y')) {
+              const uint8_t i = (text[3] == 'Y') + (text[1] == 'A' && text[2] == 'X' ? 2 : 0);
+              if (i >= 2 || (text[1] == 'I' && text[2] == 'N')) {
+                head[i] = strtod(&text[5], NULL);
+                SBI(head_found, i);
+              }
+            }
+          }
+          else if (word != SW_NONE && (NUMERIC(c) || c == '.' || c == '-' || c == '+')) {
+            if (n < sizeof(text) - 1) text[n++] = c;
+            continue;
+          }
+          else if (word != SW_NONE && n) {
+            text[n] = '\0';
+            val[word] = strtod(text, NULL);
+            SBI(seen, word);
+          }
+
+          n = 0;
+          word = SW_NONE;
+
+          if (!eol) {
+            switch (c) {
+              case ';': case '(': word = SW_COMMENT; break;
+              case 'X': case 'x': word = SW_X; break;
+              case 'Y': case 'y': word = SW_Y; break;
+              case 'Z': case 'z': word = SW_Z; break;
+              case 'E': case 'e': word = SW_E; break;
+              case 'I': case 'i': word = SW_I; break;
+              case 'J': case 'j': word = SW_J; break;
+              case 'G': case 'g': word = SW_G; break;
+              case 'M': case 'm': word = SW_M; break;
+            }
+            continue;
+          }
+
+          // End of a line
+          if (head_found == 0x0F) { done = true; break; }
+
+          if (TEST(seen, SW_G)) switch ((int)val[SW_G]) {
+            case 0: case 1: case 2: case 3: {
+              float to[XYZE];
+              LOOP_XYZE(i) {
+                const bool rel = relative || (i == E_AXIS && relative_e);
+                to[i] = TEST(seen, i) ? val[i] + (rel ? pos[i] : 0.0) : pos[i];
+              }
+              // An extruding XY move of the first layer
+              if (TEST(seen, SW_E) && to[E_AXIS] > pos[E_AXIS] && (TEST(seen, SW_X) || TEST(seen, SW_Y))) {
+                if (to[Z_AXIS] > layer_z + 0.01) { done = true; break; }
+                NOMORE(layer_z, to[Z_AXIS]);
+                LOOP_XY(i) {
+                  if (!isnan(pos[i])) { NOMORE(area[i], pos[i]); NOLESS(area[i + 2], pos[i]); }
+                  if (!isnan(to[i]))  { NOMORE(area[i], to[i]);  NOLESS(area[i + 2], to[i]); }
+                }
+                // An arc fits in the box of its circle
+                if (val[SW_G] > 1 && (TEST(seen, SW_I) || TEST(seen, SW_J)) && !isnan(pos[X_AXIS]) && !isnan(pos[Y_AXIS])) {
+                  const float ci = TEST(seen, SW_I) ? val[SW_I] : 0.0,
+                              cj = TEST(seen, SW_J) ? val[SW_J] : 0.0,
+                              r = HYPOT(ci, cj);
+                  NOMORE(area[X_AXIS], pos[X_AXIS] + ci - r);
+                  NOMORE(area[Y_AXIS], pos[Y_AXIS] + cj - r);
+                  NOLESS(area[X_AXIS + 2], pos[X_AXIS] + ci + r);
+                  NOLESS(area[Y_AXIS + 2], pos[Y_AXIS] + cj + r);
+                }
+              }
+              COPY_ARRAY(pos, to);
+            } break;
+            case 28: pos[X_AXIS] = pos[Y_AXIS] = pos[Z_AXIS] = NAN; break;
+            case 29:
+              // Only the moves after the leveling
+              layer_z = area[X_AXIS] = area[Y_AXIS] = 99999.0;
+              area[X_AXIS + 2] = area[Y_AXIS + 2] = -99999.0;
+              break;
+            case 90: relative = false; break;
+            case 91: relative = true; break;
+            case 92: LOOP_XYZE(i) if (TEST(seen, i)) pos[i] = val[i]; break;
+          }
+          else if (TEST(seen, SW_M)) {
+            if (val[SW_M] == 82) relative_e = false;
+            else if (val[SW_M] == 83) relative_e = true;
+          }
+
+          seen = 0;
+          if (done) break;
+        }
+
+        if (!(++chunks & 0x07)) printer.idle();
+      }
+
+      gcode_file.seekSet(resume);
+
+      if (head_found == 0x0F) {
+        COPY_ARRAY(area, head);
+      }
+      else if (area[X_AXIS] > area[X_AXIS + 2] || area[Y_AXIS] > area[Y_AXIS + 2])
+        return false;
+
+      min[X_AXIS] = NATIVE_X_POSITION(area[X_AXIS]);
+      min[Y_AXIS] = NATIVE_Y_POSITION(area[Y_AXIS]);
+      max[X_AXIS] = NATIVE_X_POSITION(area[X_AXIS + 2]);
+      max[Y_AXIS] = NATIVE_Y_POSITION(area[Y_AXIS + 2]);
+      return true;
+    }
+
+  #endif // ABL_PRINT_AREA_PROBING
+
   void CardReader::printStatus() {
     if (cardOK) {
       SERIAL_MV(MSG_SD_PRINTING_BYTE, sdpos);
@@ -263,6 +490,10 @@
     }
     else {
       saving = true;
+      #if ENABLED(SD_WRITE_BEHIND)
+        write_len = 0;
+        write_alloc = 0;
+      #endif
       if (!silent) {
         SERIAL_EMT(MSG_SD_WRITE_TO_FILE, filename);
         lcd_setstatus(filename);
@@ -291,9 +522,20 @@
   }
 
   void CardReader::finishWrite() {
+    #if ENABLED(SD_WRITE_BEHIND)
+      if (!flush_write_buffer()) SERIAL_LM(ER, MSG_SD_ERR_WRITE_TO_FILE);
+      #if SD_WRITE_PREALLOCATE > 0
+        // Free the clusters allocated ahead and not used, all of them for an empty file
+        if (write_alloc > gcode_file.fileSize())
+          gcode_file.truncate(gcode_file.fileSize());
+      #endif
+    #endif
     gcode_file.sync();
     gcode_file.close();
     saving = false;
+    #if ENABLED(SD_GCODE_INFO_CACHE)
+      gcode_info_clear(); // The new file can take the clusters of a deleted one
+    #endif
     SERIAL_EM(MSG_SD_FILE_SAVED);
   }
 
@@ -791,55 +1033,156 @@
   // Copy date: 27 FEB 2016                                          //
   // --------------------------------------------------------------- //
 
+  #if CPU_ARCH==ARCH_AVR
+    #define GCI_BUF_SIZE 120
+  #else
+    #define GCI_BUF_SIZE 1024
+  #endif
+
+  enum GcodeInfoState : uint8_t { GCI_DONE, GCI_HEAD, GCI_TAIL, GCI_HEIGHT };
+  enum GcodeInfoFound : uint8_t { GCI_GENBY, GCI_FIRSTLAYER, GCI_LAYER, GCI_FILAMENT };
+
   void CardReader::parsejson(SdBaseFile &parser_file) {
+    parsejson_start(parser_file);
+    while (parsejson_step(parser_file)) { /* nada */ }
+    parser_file.seekSet(0);
+  }
+
+  void CardReader::parsejson_start(SdBaseFile &parser_file) {
     fileSize = parser_file.fileSize();
     filamentNeeded    = 0.0;
     objectHeight      = 0.0;
     firstlayerHeight  = 0.0;
     layerHeight       = 0.0;
+    generatedBy[0]    = '\0';
 
-    if (!parser_file.isOpen()) return;
-
-    bool genByFound = false, firstlayerHeightFound = false, layerHeightFound = false, filamentNeedFound = false;
+    gci_state = parser_file.isOpen() ? GCI_HEAD : GCI_DONE;
+    gci_pos   = 0;
+    gci_found = 0;
+  }
 
-    #if CPU_ARCH==ARCH_AVR
-      #define GCI_BUF_SIZE 120
-    #else
-      #define GCI_BUF_SIZE 1024
-    #endif
+  /**
+   * Read and parse one buffer of the file.
+   * The scan can be suspended between two calls.
+   * Return false when the scan is done.
+   */
+  bool CardReader::parsejson_step(SdBaseFile &parser_file) {
+
+    switch (gci_state) {
+      case GCI_HEAD:    // READ 4KB FROM THE BEGINNING
+        if (gci_pos < 4096 && parser_file.seekSet(gci_pos)) break;
+        gci_state = GCI_TAIL;
+        gci_pos = 0;
+        // fallthrough
+      case GCI_TAIL:    // READ 4KB FROM END
+        if (gci_pos < 4096 && parser_file.seekEnd(-4096 + (int32_t)gci_pos)) break;
+        gci_state = GCI_HEIGHT;
+        gci_pos = GCI_BUF_SIZE;
+        // fallthrough
+      case GCI_HEIGHT:  // MOVE FROM END UP IN 1KB BLOCKS UP TO 30KB
+        if (gci_pos < 30000 && parser_file.seekEnd(-(int32_t)gci_pos)) break;
+        gci_state = GCI_DONE;
+        // fallthrough
+      default: return false;
+    }
 
-    // READ 4KB FROM THE BEGINNING
     char buf[GCI_BUF_SIZE];
-    for (int i = 0; i < 4096; i += GCI_BUF_SIZE - 50) {
-      if(!parser_file.seekSet(i)) break;
-      parser_file.read(buf, GCI_BUF_SIZE);
-      if (!genByFound && findGeneratedBy(buf, generatedBy)) genByFound = true;
-      if (!firstlayerHeightFound && findFirstLayerHeight(buf, firstlayerHeight)) firstlayerHeightFound = true;
-      if (!layerHeightFound && findLayerHeight(buf, layerHeight)) layerHeightFound = true;
-      if (!filamentNeedFound && findFilamentNeed(buf, filamentNeeded)) filamentNeedFound = true;
-      if(genByFound && layerHeightFound && filamentNeedFound) goto get_objectHeight;
+    const int len = parser_file.read(buf, GCI_BUF_SIZE - 1);
+    buf[len > 0 ? len : 0] = '\0';
+    gci_pos += GCI_BUF_SIZE - 50;
+
+    if (gci_state == GCI_HEIGHT) {
+      if (findTotalHeight(buf, objectHeight)) gci_state = GCI_DONE;
+    }
+    else {
+      if (!TEST(gci_found, GCI_GENBY) && findGeneratedBy(buf, generatedBy)) SBI(gci_found, GCI_GENBY);
+      if (!TEST(gci_found, GCI_FIRSTLAYER) && findFirstLayerHeight(buf, firstlayerHeight)) SBI(gci_found, GCI_FIRSTLAYER);
+      if (!TEST(gci_found, GCI_LAYER) && findLayerHeight(buf, layerHeight)) SBI(gci_found, GCI_LAYER);
+      if (!TEST(gci_found, GCI_FILAMENT) && findFilamentNeed(buf, filamentNeeded)) SBI(gci_found, GCI_FILAMENT);
+      if (TEST(gci_found, GCI_GENBY) && TEST(gci_found, GCI_LAYER) && TEST(gci_found, GCI_FILAMENT)) {
+        gci_state = GCI_HEIGHT;
+        gci_pos = GCI_BUF_SIZE;
+      }
+    }
+
+    return gci_state != GCI_DONE;
+  }
+
+  #if ENABLED(SD_GCODE_INFO_CACHE)
+
+    /**
+     * G-code info of the selected file.
+     * The most recently used files are kept in RAM keyed by first cluster,
+     * size and date of the directory entry. A file not in the cache is scanned
+     * with a second handle a buffer at a time from the main loop, so the
+     * selection returns at once and the print is not disturbed.
+     */
+    void CardReader::gcode_info_select(const char* filename) {
+
+      gcode_info_abort();
+
+      dir_t dir;
+      gci_cluster = gcode_file.firstCluster();
+      gci_date = gcode_file.dirEntry(&dir) ? ((uint32_t)dir.lastWriteDate << 16) | dir.lastWriteTime : 0;
+
+      for (uint8_t i = 0; i < SD_GCODE_INFO_CACHE_SIZE; i++) {
+        const gcode_info_t &info = gci_cache[i];
+        if (info.cluster && info.cluster == gci_cluster && info.size == fileSize && info.date == gci_date) {
+          objectHeight      = info.objectHeight;
+          firstlayerHeight  = info.firstlayerHeight;
+          layerHeight       = info.layerHeight;
+          filamentNeeded    = info.filamentNeeded;
+          strcpy(generatedBy, info.generatedBy);
+          // Move to the front of the cache
+          if (i) {
+            const gcode_info_t hit = info;
+            memmove(&gci_cache[1], &gci_cache[0], i * sizeof(gcode_info_t));
+            gci_cache[0] = hit;
+          }
+          return;
+        }
+      }
+
+      if (gci_file.open(curDir, filename, O_READ))
+        parsejson_start(gci_file);
+      else
+        parsejson(gcode_file);
     }
 
-    // READ 4KB FROM END
-    for (int i = 0; i < 4096; i += GCI_BUF_SIZE - 50) {
-      if(!parser_file.seekEnd(-4096 + i)) break;
-      parser_file.read(buf, GCI_BUF_SIZE);
-      if (!genByFound && findGeneratedBy(buf, generatedBy)) genByFound = true;
-      if (!firstlayerHeightFound && findFirstLayerHeight(buf, firstlayerHeight)) firstlayerHeightFound = true;
-      if (!layerHeightFound && findLayerHeight(buf, layerHeight)) layerHeightFound = true;
-      if (!filamentNeedFound && findFilamentNeed(buf, filamentNeeded)) filamentNeedFound = true;
-      if(genByFound && layerHeightFound && filamentNeedFound) goto get_objectHeight;
+    void CardReader::gcode_info_spin() {
+      if (gci_state == GCI_DONE || parsejson_step(gci_file)) return;
+
+      gci_file.close();
+      if (!gci_cluster) return;
+
+      // Drop the least recently used file
+      memmove(&gci_cache[1], &gci_cache[0], (SD_GCODE_INFO_CACHE_SIZE - 1) * sizeof(gcode_info_t));
+      gcode_info_t &info = gci_cache[0];
+      info.cluster          = gci_cluster;
+      info.size             = fileSize;
+      info.date             = gci_date;
+      info.objectHeight     = objectHeight;
+      info.firstlayerHeight = firstlayerHeight;
+      info.layerHeight      = layerHeight;
+      info.filamentNeeded   = filamentNeeded;
+      strcpy(info.generatedBy, generatedBy);
     }
 
-    get_objectHeight:
-    // MOVE FROM END UP IN 1KB BLOCKS UP TO 30KB
-    for (int i = GCI_BUF_SIZE; i < 30000; i += GCI_BUF_SIZE - 50) {
-      if(!parser_file.seekEnd(-i)) break;
-      parser_file.read(buf, GCI_BUF_SIZE);
-      if (findTotalHeight(buf, objectHeight)) break;
+    void CardReader::gcode_info_finish() {
+      while (gci_state != GCI_DONE) gcode_info_spin();
     }
-    parser_file.seekSet(0);
-  }
+
+    void CardReader::gcode_info_abort() {
+      gci_state = GCI_DONE;
+      gci_file.close();
+    }
+
+    void CardReader::gcode_info_clear() {
+      gcode_info_abort();
+      ZERO(gci_cache);
+    }
+
+  #endif // SD_GCODE_INFO_CACHE
 
   void CardReader::printEscapeChars(const char* s) {
     for (unsigned int i = 0; i < strlen(s); ++i) {
@@ -972,7 +1315,7 @@
   }
 
   bool CardReader::findTotalHeight(char* buf, float &height) {
-    int len = 1024;
+    int len = strlen(buf);
     bool inComment, inRelativeMode = false;
     unsigned int zPos;
     for (int i = len - 5; i > 0; i--) {
@@ -84,6 +84,41 @@
       LsAction  lsAction;            // stored for recursion.
       bool  autostart_stilltocheck;  // the sd start is delayed, because otherwise the serial cannot answer fast enought to make contact with the hostsoftware.
 
+      #if ENABLED(SD_READ_AHEAD)
+        uint8_t   read_buffer[SD_READ_AHEAD_SIZE];  // G-code read ahead of the command reader
+        uint16_t  read_len,                         // Bytes in the buffer
+                  read_pos;                         // Next byte to get
+      #endif
+
+      #if ENABLED(SD_WRITE_BEHIND)
+        uint8_t   write_buffer[SD_WRITE_BEHIND_SIZE]; // Uploaded lines not yet written
+        uint16_t  write_len;                          // Bytes in the buffer
+        uint32_t  write_alloc;                        // Bytes allocated to the file being written
+      #endif
+
+      // Resumable scan of the G-code info
+      uint16_t  gci_pos;
+      uint8_t   gci_state,
+                gci_found;
+
+      #if ENABLED(SD_GCODE_INFO_CACHE)
+        typedef struct {
+          uint32_t  cluster,
+                    size,
+                    date;
+          float     objectHeight,
+                    firstlayerHeight,
+                    layerHeight,
+                    filamentNeeded;
+          char      generatedBy[GENBY_SIZE];
+        } gcode_info_t;
+
+        SdFile        gci_file;                           // Second handle for the scan of the selected file
+        uint32_t      gci_cluster,
+                      gci_date;
+        gcode_info_t  gci_cache[SD_GCODE_INFO_CACHE_SIZE]; // Most recently used first
+      #endif
+
       // Sort files and folders alphabetically.
       #if ENABLED(SDCARD_SORT_ALPHA)
         uint16_t sort_count;        // Count of sorted items in the current directory
@@ -158,6 +193,10 @@
 
       uint16_t get_num_Files();
 
+      #if ENABLED(ABL_PRINT_AREA_PROBING)
+        bool scan_print_area(float min[2], float max[2]); // XY box of the first layer of the open file
+      #endif
+
       #if HAS_EEPROM_SD
         bool write_data(SdFile* currentfile, const uint8_t value);
         uint8_t read_data(SdFile* currentfile);
@@ -193,10 +232,25 @@
       #endif
 
       FORCE_INLINE void pauseSDPrint() { sdprinting = false; }
-      FORCE_INLINE void setIndex(uint32_t newpos) { sdpos = newpos; gcode_file.seekSet(sdpos); }
+      #if ENABLED(SD_READ_AHEAD)
+        FORCE_INLINE void setIndex(uint32_t newpos) { sdpos = newpos; gcode_file.seekSet(sdpos); read_len = read_pos = 0; }
+      #else
+        FORCE_INLINE void setIndex(uint32_t newpos) { sdpos = newpos; gcode_file.seekSet(sdpos); }
+      #endif
       FORCE_INLINE bool isFileOpen() { return gcode_file.isOpen(); }
       FORCE_INLINE bool eof() { return sdpos >= fileSize; }
-      FORCE_INLINE int16_t get() { sdpos = gcode_file.curPosition(); return (int16_t)gcode_file.read(); }
+      #if ENABLED(SD_READ_AHEAD)
+        FORCE_INLINE int16_t get() {
+          if (read_pos >= read_len && !fill_read_buffer()) {
+            sdpos = gcode_file.curPosition();
+            return -1;
+          }
+          sdpos = gcode_file.curPosition() - read_len + read_pos;
+          return read_buffer[read_pos++];
+        }
+      #else
+        FORCE_INLINE int16_t get() { sdpos = gcode_file.curPosition(); return (int16_t)gcode_file.read(); }
+      #endif
       FORCE_INLINE uint8_t percentDone() { return (isFileOpen() && fileSize) ? sdpos / ((fileSize + 99) / 100) : 0; }
       FORCE_INLINE char* getWorkDirName() { workDir.getFilename(fileName); return fileName; }
 
@@ -206,10 +260,24 @@
 
       static void printEscapeChars(const char* s);
 
+      #if ENABLED(SD_GCODE_INFO_CACHE)
+        void gcode_info_spin();     // Scan a piece of the selected file, from the main loop
+        void gcode_info_finish();   // Complete the scan before using the info
+      #endif
+
     private: /** Private Function */
 
       void lsDive(SdBaseFile parent, const char* const match = NULL);
+
+      #if ENABLED(SD_READ_AHEAD)
+        bool fill_read_buffer();
+      #endif
+      #if ENABLED(SD_WRITE_BEHIND)
+        bool flush_write_buffer();
+      #endif
       void parsejson(SdBaseFile &parser_file);
+      void parsejson_start(SdBaseFile &parser_file);
+      bool parsejson_step(SdBaseFile &parser_file);
       bool findGeneratedBy(char* buf, char* genBy);
       bool findFirstLayerHeight(char* buf, float &firstlayerHeight);
       bool findLayerHeight(char* buf, float &layerHeight);
@@ -220,6 +288,12 @@
         void flush_presort();
       #endif
 
+      #if ENABLED(SD_GCODE_INFO_CACHE)
+        void gcode_info_select(const char* filename);
+        void gcode_info_abort();
+        void gcode_info_clear();
+      #endif
+
   };
 
   extern CardReader card;
@@ -52,6 +52,33 @@
   #if ENABLED(SD_SETTINGS) && DISABLED(SD_CFG_SECONDS)
     #error DEPENDENCY ERROR: Missing setting SD_CFG_SECONDS
   #endif
+  #if ENABLED(SD_READ_AHEAD)
+    #if DISABLED(SD_READ_AHEAD_SIZE)
+      #error DEPENDENCY ERROR: Missing setting SD_READ_AHEAD_SIZE
+    #elif (SD_READ_AHEAD_SIZE) % 512 != 0 || !WITHIN(SD_READ_AHEAD_SIZE, 512, 16384)
+      #error CONFLICT ERROR: SD_READ_AHEAD_SIZE must be a multiple of 512 between 512 and 16384
+    #endif
+  #endif
+  #if ENABLED(SD_WRITE_BEHIND)
+    #if DISABLED(SD_WRITE_BEHIND_SIZE)
+      #error DEPENDENCY ERROR: Missing setting SD_WRITE_BEHIND_SIZE
+    #elif (SD_WRITE_BEHIND_SIZE) % 512 != 0 || !WITHIN(SD_WRITE_BEHIND_SIZE, 512, 16384)
+      #error CONFLICT ERROR: SD_WRITE_BEHIND_SIZE must be a multiple of 512 between 512 and 16384
+    #endif
+    #if DISABLED(SD_WRITE_PREALLOCATE)
+      #error DEPENDENCY ERROR: Missing setting SD_WRITE_PREALLOCATE
+    #endif
+  #endif
+  #if ENABLED(SD_GCODE_INFO_CACHE)
+    #if DISABLED(JSON_OUTPUT)
+      #error DEPENDENCY ERROR: You have to enable JSON_OUTPUT to use SD_GCODE_INFO_CACHE
+    #endif
+    #if DISABLED(SD_GCODE_INFO_CACHE_SIZE)
+      #error DEPENDENCY ERROR: Missing setting SD_GCODE_INFO_CACHE_SIZE
+    #elif !WITHIN(SD_GCODE_INFO_CACHE_SIZE, 2, 64)
+      #error CONFLICT ERROR: SD_GCODE_INFO_CACHE_SIZE must be between 2 and 64
+    #endif
+  #endif
 #endif
 
 #endif /* _SD_CARD_SANITYCHECK_H_ */
@@ -310,4 +310,26 @@
   #endif
 #endif
 
+#if ENABLED(STEPPER_RING)
+  #if DISABLED(ARDUINO_ARCH_SAM)
+    #error "STEPPER_RING requires a 32 bit board."
+  #elif DISABLED(STEPPER_RING_SIZE)
+    #error DEPENDENCY ERROR: Missing setting STEPPER_RING_SIZE
+  #elif (STEPPER_RING_SIZE & (STEPPER_RING_SIZE - 1)) || STEPPER_RING_SIZE < 16 || STEPPER_RING_SIZE > 1024
+    #error DEPENDENCY ERROR: STEPPER_RING_SIZE must be a power of 2 from 16 to 1024
+  #elif DISABLED(STEPPER_RING_FREQUENCY)
+    #error DEPENDENCY ERROR: Missing setting STEPPER_RING_FREQUENCY
+  #elif ENABLED(LIN_ADVANCE)
+    #error "STEPPER_RING is not compatible with LIN_ADVANCE."
+  #elif ENABLED(LASER)
+    #error "STEPPER_RING is not compatible with LASER."
+  #elif ENABLED(COLOR_MIXING_EXTRUDER)
+    #error "STEPPER_RING is not compatible with COLOR_MIXING_EXTRUDER."
+  #elif ENABLED(Z_LATE_ENABLE)
+    #error "STEPPER_RING is not compatible with Z_LATE_ENABLE."
+  #elif HAS_EXT_ENCODER
+    #error "STEPPER_RING is not compatible with the extruder encoders."
+  #endif
+#endif
+
 #endif /* _STEPPER_SANITYCHECK_H_ */
@@ -106,6 +106,23 @@ long  Stepper::counter_X = 0,
 
 volatile uint32_t Stepper::step_events_completed = 0; // The number of step events executed in the current block
 
+block_t* volatile Stepper::aborted_block = NULL;
+
+#if ENABLED(STEPPER_RING)
+  volatile step_event_t Stepper::step_ring[STEPPER_RING_SIZE];
+  volatile uint16_t     Stepper::step_ring_head = 0,
+                        Stepper::step_ring_tail = 0;
+#else
+  volatile segment_t  Stepper::segment_buffer[SEGMENT_BUFFER_SIZE];
+  volatile uint8_t    Stepper::segment_head = 0,
+                      Stepper::segment_tail = 0;
+  volatile segment_t* Stepper::current_segment = NULL;
+  uint16_t            Stepper::segment_steps_left = 0;
+#endif
+
+block_t* Stepper::prep_block = NULL;
+uint32_t Stepper::prep_step_events = 0;
+
 #if ENABLED(LIN_ADVANCE)
 
   hal_timer_t  Stepper::nextMainISR = 0,
@@ -114,8 +131,7 @@ volatile uint32_t Stepper::step_events_completed = 0; // The number of step even
 
   volatile int  Stepper::e_steps[DRIVER_EXTRUDERS];
 
-  int Stepper::final_estep_rate,
-      Stepper::current_estep_rate[DRIVER_EXTRUDERS],
+  int Stepper::current_estep_rate[DRIVER_EXTRUDERS],
       Stepper::current_adv_steps[DRIVER_EXTRUDERS];
 
   FORCE_INLINE hal_timer_t adv_rate(const int steps, const hal_timer_t timer, const uint8_t loops) {
@@ -427,12 +443,48 @@ void Stepper::set_directions() {
   #endif
 }
 
+#define ENDSTOP_NOMINAL_OCR_VAL (int)(1500 * STEPPER_TIMER_TICKS_PER_US) // check endstops every 1.5ms to guarantee two stepper ISRs within 5ms for BLTouch
+#define OCR_VAL_TOLERANCE       (int)(500 * STEPPER_TIMER_TICKS_PER_US)  // First max delay is 2.0ms, last min delay is 0.5ms, all others 1.5ms
+
+#define _COUNTER(AXIS) counter_## AXIS
+#define _APPLY_STEP(AXIS) AXIS ##_APPLY_STEP
+#define _INVERT_STEP_PIN(AXIS) INVERT_## AXIS ##_STEP_PIN
+
+#define _COUNT_STEPPERS_0 0
+#if HAS_X_STEP
+  #define _COUNT_STEPPERS_1 (_COUNT_STEPPERS_0 + 1)
+#else
+  #define _COUNT_STEPPERS_1 _COUNT_STEPPERS_0
+#endif
+#if HAS_Y_STEP
+  #define _COUNT_STEPPERS_2 (_COUNT_STEPPERS_1 + 1)
+#else
+  #define _COUNT_STEPPERS_2 _COUNT_STEPPERS_1
+#endif
+#if HAS_Z_STEP
+  #define _COUNT_STEPPERS_3 (_COUNT_STEPPERS_2 + 1)
+#else
+  #define _COUNT_STEPPERS_3 _COUNT_STEPPERS_2
+#endif
+#if DISABLED(LIN_ADVANCE)
+  #define _COUNT_STEPPERS_4 (_COUNT_STEPPERS_3 + 1)
+#else
+  #define _COUNT_STEPPERS_4 _COUNT_STEPPERS_3
+#endif
+
+#define CYCLES_EATEN_XYZE (_COUNT_STEPPERS_4 * 5)
+#define EXTRA_CYCLES_XYZE (STEP_PULSE_CYCLES - (CYCLES_EATEN_XYZE))
+
 /**
  * Stepper Driver Interrupt
  *
  * Directly pulses the stepper motors at high frequency.
  * Timer 1 runs at a base frequency of 2MHz, with this ISR using OCR1A compare mode.
  *
+ * The step rates are not computed here: the blocks are cut by prepare_segments(),
+ * at a lower priority, into segments of constant step rate and this ISR only runs
+ * the Bresenham line tracer over them.
+ *
  * OCR1A   Frequency
  *     1     2 MHz
  *    50    40 KHz
@@ -443,19 +495,44 @@ void Stepper::set_directions() {
  */
 HAL_STEP_TIMER_ISR {
   HAL_timer_isr_prologue(STEPPER_TIMER);
-  #if ENABLED(LIN_ADVANCE)
+  #if ENABLED(STEPPER_RING)
+    Stepper::ring_isr();
+  #elif ENABLED(LIN_ADVANCE)
     Stepper::advance_isr_scheduler();
   #else
     Stepper::isr();
   #endif
 }
 
+#if ENABLED(ARDUINO_ARCH_SAM)
+
+  /**
+   * Step preparation interrupt
+   *
+   * Runs at STEPPER_PREP_FREQUENCY with a lower priority than the stepper
+   * ISR, which keeps stepping what is already prepared.
+   * On AVR the preparation runs at the end of the temperature ISR.
+   */
+  HAL_STEPPER_PREP_TIMER_ISR {
+    HAL_timer_isr_prologue(STEPPER_PREP_TIMER);
+    #if ENABLED(STEPPER_RING)
+      Stepper::fill_step_ring();
+    #else
+      Stepper::prepare_segments();
+    #endif
+  }
+
+#endif
+
+#if DISABLED(STEPPER_RING)
+
+#define SEGMENT_MOD(n) ((n) & (SEGMENT_BUFFER_SIZE - 1))
+
 void Stepper::isr() {
 
-  hal_timer_t ocr_val;
+  CYCLE_PROBE(STEPPER_ISR);
 
-  #define ENDSTOP_NOMINAL_OCR_VAL (int)(1500 * STEPPER_TIMER_TICKS_PER_US) // check endstops every 1.5ms to guarantee two stepper ISRs within 5ms for BLTouch
-  #define OCR_VAL_TOLERANCE       (int)(500 * STEPPER_TIMER_TICKS_PER_US)  // First max delay is 2.0ms, last min delay is 0.5ms, all others 1.5ms
+  hal_timer_t ocr_val;
 
   #if DISABLED(LIN_ADVANCE)
     // Allow UART ISRs
@@ -533,16 +610,33 @@ void Stepper::isr() {
     #endif
   #endif
 
-  // If there is no current block, attempt to pop one from the buffer
-  if (!current_block) {
+  // If there is no current segment, attempt to pop one from the buffer
+  if (!current_segment) {
+
+    // Drop the segments left of a block aborted by an endstop
+    while (aborted_block && segment_tail != segment_head) {
+      if (TEST(segment_buffer[segment_tail].flag, SEGMENT_BIT_END)) aborted_block = NULL;
+      segment_tail = SEGMENT_MOD(segment_tail + 1);
+    }
+
     // Anything in the buffer?
-    current_block = planner.get_current_block();
-    if (current_block) {
-      trapezoid_generator_reset();
+    if (aborted_block || segment_tail == segment_head) {
+      // Look again sooner if the segments of a block are on the way
+      _NEXT_ISR(planner.blocks_queued() ? HAL_STEPPER_TIMER_RATE / 10000 : HAL_STEPPER_TIMER_RATE / 1000);
+      HAL_ENABLE_ISRs(); // re-enable ISRs
+      return;
+    }
 
-      #if STEPPER_DIRECTION_DELAY > 0
-        HAL::delayMicroseconds(STEPPER_DIRECTION_DELAY);
-      #endif
+    current_segment = &segment_buffer[segment_tail];
+    segment_steps_left = current_segment->n_step;
+    step_loops = current_segment->step_loops;
+
+    if (TEST(current_segment->flag, SEGMENT_BIT_START)) {
+
+      // The blocks before it are discarded, so it's at the tail of the planner
+      current_block = &planner.block_buffer[planner.block_buffer_tail];
+
+      set_block_directions();
 
       // Initialize Bresenham counters to 1/2 the ceiling
       counter_X = counter_Y = counter_Z = counter_E = -(current_block->step_event_count >> 1);
@@ -570,6 +664,10 @@ void Stepper::isr() {
                             // No 'change' can be detected.
       #endif
 
+      #if ENABLED(LASER) && ENABLED(LASER_RASTER)
+         if (current_block->laser_mode == RASTER) counter_raster = 0;
+      #endif
+
       #if ENABLED(Z_LATE_ENABLE)
         if (current_block->steps[Z_AXIS] > 0) {
           enable_Z();
@@ -578,17 +676,19 @@ void Stepper::isr() {
           return;
         }
       #endif
-
-      #if ENABLED(LASER) && ENABLED(LASER_RASTER)
-         if (current_block->laser_mode == RASTER) counter_raster = 0;
-      #endif
-
-    }
-    else {
-      _NEXT_ISR(HAL_STEPPER_TIMER_RATE / 1000); // Run at slow speed - 1 KHz
-      HAL_ENABLE_ISRs(); // re-enable ISRs
-      return;
     }
+
+    #if ENABLED(LIN_ADVANCE)
+      if (current_block->use_advance_lead) {
+        const uint32_t step_rate = current_segment->step_rate;
+        #if ENABLED(COLOR_MIXING_EXTRUDER)
+          MIXING_STEPPERS_LOOP(j)
+            current_estep_rate[j] = (step_rate * current_block->abs_adv_steps_multiplier8 * current_block->step_event_count / current_block->mix_event_count[j]) >> 17;
+        #else
+          current_estep_rate[TOOL_E_INDEX] = (step_rate * current_block->abs_adv_steps_multiplier8) >> 17;
+        #endif
+      }
+    #endif
   }
 
   // Update endstops state, if enabled
@@ -615,10 +715,6 @@ void Stepper::isr() {
     #endif
   #endif
 
-  #define _COUNTER(AXIS) counter_## AXIS
-  #define _APPLY_STEP(AXIS) AXIS ##_APPLY_STEP
-  #define _INVERT_STEP_PIN(AXIS) INVERT_## AXIS ##_STEP_PIN
-
   // Advance the Bresenham counter; start a pulse if the axis needs a step
   #define PULSE_START(AXIS) \
     _COUNTER(AXIS) += current_block->steps[AXIS ##_AXIS]; \
@@ -632,30 +728,6 @@ void Stepper::isr() {
       _APPLY_STEP(AXIS)(_INVERT_STEP_PIN(AXIS),0); \
     }
 
-  #define _COUNT_STEPPERS_0 0
-  #if HAS_X_STEP
-    #define _COUNT_STEPPERS_1 (_COUNT_STEPPERS_0 + 1)
-  #else
-    #define _COUNT_STEPPERS_1 _COUNT_STEPPERS_0
-  #endif
-  #if HAS_Y_STEP
-    #define _COUNT_STEPPERS_2 (_COUNT_STEPPERS_1 + 1)
-  #else
-    #define _COUNT_STEPPERS_2 _COUNT_STEPPERS_1
-  #endif
-  #if HAS_Z_STEP
-    #define _COUNT_STEPPERS_3 (_COUNT_STEPPERS_2 + 1)
-  #else
-    #define _COUNT_STEPPERS_3 _COUNT_STEPPERS_2
-  #endif
-  #if DISABLED(LIN_ADVANCE)
-    #define _COUNT_STEPPERS_4 (_COUNT_STEPPERS_3 + 1)
-  #else
-    #define _COUNT_STEPPERS_4 _COUNT_STEPPERS_3
-  #endif
-
-  #define CYCLES_EATEN_XYZE (_COUNT_STEPPERS_4 * 5)
-  #define EXTRA_CYCLES_XYZE (STEP_PULSE_CYCLES - (CYCLES_EATEN_XYZE))
 
   // Take multiple steps per interrupt (For high speed moves)
   bool all_steps_done = false;
@@ -834,11 +906,15 @@ void Stepper::isr() {
       #endif // DISABLED(LASER_PULSE_METHOD)
     #endif // LASER
 
+    --segment_steps_left;
+
     if (++step_events_completed >= current_block->step_event_count) {
       all_steps_done = true;
       break;
     }
 
+    if (!segment_steps_left) break;
+
     // For minimum pulse time wait before stopping pulses
     #if EXTRA_CYCLES_XYZE > 20
       if (i) while (EXTRA_CYCLES_XYZE > (uint32_t)(HAL_timer_get_current_count(STEPPER_TIMER) - pulse_start) * (STEPPER_TIMER_PRESCALE)) { /* nada */ }
@@ -867,128 +943,407 @@ void Stepper::isr() {
 
   #endif
 
-  // Calculate new timer value
-  if (step_events_completed <= (uint32_t)current_block->accelerate_until) {
+  // The step rate is constant along the segment
+  const hal_timer_t interval = current_segment->interval;
 
-    HAL_MULTI_ACC(acc_step_rate, acceleration_time, current_block->acceleration_rate);
-    acc_step_rate += current_block->initial_rate;
+  SPLIT(interval); // split step into multiple ISRs if larger than ENDSTOP_NOMINAL_OCR_VAL
+  _NEXT_ISR(ocr_val);
 
-    // upper limit
-    NOMORE(acc_step_rate, current_block->nominal_rate);
+  #if ENABLED(LIN_ADVANCE)
+    eISR_Rate = adv_rate(e_steps[TOOL_E_INDEX], interval, step_loops);
+  #endif
 
-    // step_rate to timer interval
-    const hal_timer_t timer = calc_timer(acc_step_rate);
+  #if DISABLED(LIN_ADVANCE)
+    #if ENABLED(CPU_32_BIT)
+      hal_timer_t stepper_timer_count = HAL_timer_get_count(STEPPER_TIMER);
+      NOLESS(stepper_timer_count, (HAL_timer_get_current_count(STEPPER_TIMER) + 8 * STEPPER_TIMER_TICKS_PER_US));
+      HAL_TIMER_SET_STEPPER_COUNT(stepper_timer_count);
+    #else
+      NOLESS(OCR1A, TCNT1 + 16);
+    #endif
+  #endif
 
-    SPLIT(timer);  // split step into multiple ISRs if larger than ENDSTOP_NOMINAL_OCR_VAL
-    _NEXT_ISR(ocr_val);
+  // If the segment is finished, give it back to the preparation
+  if (all_steps_done || !segment_steps_left) {
+    // Nothing more to drop if the aborted block ends with it
+    if (TEST(current_segment->flag, SEGMENT_BIT_END)) aborted_block = NULL;
+    current_segment = NULL;
+    segment_tail = SEGMENT_MOD(segment_tail + 1);
+  }
 
-    acceleration_time += timer;
+  // If current block is finished, reset pointer
+  if (all_steps_done) {
+    #if ENABLED(MOTION_STATS)
+      motionstats.block_done(current_block->step_event_count);
+    #endif
+    current_block = NULL;
+    planner.discard_current_block();
 
-    #if ENABLED(LIN_ADVANCE)
+    #if ENABLED(ARDUINO_ARCH_SAM)
+      #if ENABLED(LASER)
+        laser.extinguish();
+      #endif
+    #else
+      #if ENABLED(LASER) && ENABLED(LASER_PULSE_METHOD)
+        if (current_block->laser_mode == CONTINUOUS && current_block->laser_status == LASER_ON)
+          laser.extinguish();
+      #endif
+    #endif
+  }
 
-      if (current_block->use_advance_lead) {
-        #if ENABLED(COLOR_MIXING_EXTRUDER)
-          MIXING_STEPPERS_LOOP(j)
-            current_estep_rate[j] = ((uint32_t)acc_step_rate * current_block->abs_adv_steps_multiplier8 * current_block->step_event_count / current_block->mix_event_count[j]) >> 17;
-        #else
-          current_estep_rate[TOOL_E_INDEX] = ((uint32_t)acc_step_rate * current_block->abs_adv_steps_multiplier8) >> 17;
-        #endif
-      }
+  #if DISABLED(LIN_ADVANCE)
+    HAL_ENABLE_ISRs(); // re-enable ISRs
+  #endif
+}
 
-      eISR_Rate = adv_rate(e_steps[TOOL_E_INDEX], timer, step_loops);
+/**
+ * Cut the planned blocks into segments of constant step rate, until the
+ * segment buffer is full or there are no more blocks.
+ * The rate of each segment is the rate of the acceleration ramp at its
+ * middle time, so the segments follow the ramp of the stepper ISR.
+ */
+void Stepper::prepare_segments() {
 
-    #endif // ENABLED(LIN_ADVANCE)
-  }
-  else if (step_events_completed > (uint32_t)current_block->decelerate_after) {
-    hal_timer_t step_rate;
-    HAL_MULTI_ACC(step_rate, deceleration_time, current_block->acceleration_rate);
+  CYCLE_PROBE(STEP_PREP);
+
+  // Blocks are being discarded
+  if (cleaning_buffer_counter) return;
+
+  uint8_t head = segment_head;
+
+  while (SEGMENT_MOD(head + 1) != segment_tail) {
+
+    uint8_t flag = 0;
 
-    if (step_rate < acc_step_rate) {
-      step_rate = acc_step_rate - step_rate; // Decelerate from acceleration end point.
-      NOLESS(step_rate, current_block->final_rate);
+    if (!prep_block) {
+      prep_block = planner.get_next_block();
+      if (!prep_block) break;
+      trapezoid_generator_reset();
+      SBI(flag, SEGMENT_BIT_START);
     }
-    else {
-      step_rate = current_block->final_rate;
+
+    hal_timer_t step_rate, interval = 0;
+    uint8_t loops = 1;
+    uint32_t n_step = 0;
+
+    if (aborted_block == prep_block) {
+      // An endstop aborted the block, close it with an empty segment
+      step_rate = prep_block->final_rate;
     }
+    else {
+      uint32_t phase_end;
+      long *ramp_time = NULL;
+
+      if (prep_step_events < (uint32_t)prep_block->accelerate_until) {
+        step_rate = accelerate_rate(acceleration_time + (SEGMENT_TICKS >> 1));
+        phase_end = prep_block->accelerate_until;
+        ramp_time = &acceleration_time;
+      }
+      else if (prep_step_events < (uint32_t)prep_block->decelerate_after) {
+        step_rate = prep_block->nominal_rate;
+        phase_end = prep_block->decelerate_after;
+      }
+      else {
+        step_rate = decelerate_rate(deceleration_time + (SEGMENT_TICKS >> 1));
+        phase_end = prep_block->step_event_count;
+        ramp_time = &deceleration_time;
+      }
+
+      if (ramp_time)
+        interval = calc_timer(step_rate, loops);
+      else {
+        interval = OCR1A_nominal;
+        loops = step_loops_nominal;
+      }
+
+      // Stepper ISRs in the segment, the segment ends with the ramp phase
+      uint32_t n_isr = SEGMENT_TICKS / interval;
+      if (!n_isr) n_isr = 1;
+      n_step = n_isr * loops;
+      if (n_step > phase_end - prep_step_events) {
+        n_step = phase_end - prep_step_events;
+        n_isr = (n_step + loops - 1) / loops;
+      }
 
-    // step_rate to timer interval
-    const hal_timer_t timer = calc_timer(step_rate);
+      if (ramp_time) *ramp_time += n_isr * interval;
+      prep_step_events += n_step;
 
-    SPLIT(timer); // split step into multiple ISRs if larger than ENDSTOP_NOMINAL_OCR_VAL
-    _NEXT_ISR(ocr_val);
+      // The deceleration starts from the rate at the end of the acceleration,
+      // not from the mid-segment rate used for the last acceleration segment
+      if (ramp_time == &acceleration_time) {
+        acc_step_rate = (prep_step_events >= (uint32_t)prep_block->accelerate_until && prep_block->decelerate_after > prep_block->accelerate_until)
+          ? prep_block->nominal_rate
+          : accelerate_rate(acceleration_time);
+      }
+    }
 
-    deceleration_time += timer;
+    if (n_step == 0 || prep_step_events >= prep_block->step_event_count) {
+      SBI(flag, SEGMENT_BIT_END);
+      prep_block = NULL;
+    }
 
+    volatile segment_t &segment = segment_buffer[head];
+    segment.interval = interval;
+    segment.n_step = n_step;
+    segment.step_loops = loops;
+    segment.flag = flag;
     #if ENABLED(LIN_ADVANCE)
+      segment.step_rate = step_rate;
+    #endif
 
-      if (current_block->use_advance_lead) {
-        #if ENABLED(MIXING_EXTRUDER_FEATURE)
-          MIXING_STEPPERS_LOOP(j)
-            current_estep_rate[j] = ((uint32_t)step_rate * current_block->abs_adv_steps_multiplier8 * current_block->step_event_count / current_block->mix_event_count[j]) >> 17;
-        #else
-          current_estep_rate[TOOL_E_INDEX] = ((uint32_t)step_rate * current_block->abs_adv_steps_multiplier8) >> 17;
-        #endif
+    // Publish the segment to the stepper ISR
+    head = SEGMENT_MOD(head + 1);
+    segment_head = head;
+  }
+}
+
+#endif // !STEPPER_RING
+
+#if ENABLED(STEPPER_RING)
+
+  #define STEP_RING_MOD(n) ((n) & (STEPPER_RING_SIZE - 1))
+
+  /**
+   * Compute the step events of the planned blocks into the ring,
+   * until the ring is full or there are no more blocks.
+   * Each event holds the axes to step and the timer interval to the
+   * next event, so the Bresenham tracer and the acceleration ramps
+   * run here and the stepper ISR only has to pulse the pins.
+   */
+  void Stepper::fill_step_ring() {
+
+    CYCLE_PROBE(STEP_PREP);
+
+    // Blocks are being discarded
+    if (cleaning_buffer_counter) return;
+
+    uint16_t head = step_ring_head;
+
+    while (STEP_RING_MOD(head + 1) != step_ring_tail) {
+
+      uint8_t step_bits = 0, flag = 0;
+      hal_timer_t interval;
+
+      if (!prep_block) {
+        prep_block = planner.get_next_block();
+        if (!prep_block) break;
+
+        // Initialize Bresenham counters to 1/2 the ceiling
+        counter_X = counter_Y = counter_Z = counter_E = -(prep_block->step_event_count >> 1);
+        trapezoid_generator_reset();
+
+        SBI(flag, STEP_EVENT_BIT_START);
+      }
+
+      // Advance the Bresenham counter; set the bit if the axis needs a step
+      #define RING_STEP(AXIS) \
+        _COUNTER(AXIS) += prep_block->steps[AXIS ##_AXIS]; \
+        if (_COUNTER(AXIS) > 0) { \
+          _COUNTER(AXIS) -= prep_block->step_event_count; \
+          SBI(step_bits, AXIS ##_AXIS); \
+        }
+
+      RING_STEP(X);
+      RING_STEP(Y);
+      RING_STEP(Z);
+      RING_STEP(E);
+
+      // Interval to the next step event, like the stepper ISR does
+      uint8_t loops;
+      if (++prep_step_events <= (uint32_t)prep_block->accelerate_until) {
+        acc_step_rate = accelerate_rate(acceleration_time);
+        interval = calc_timer(acc_step_rate, loops);
+        acceleration_time += interval;
+      }
+      else if (prep_step_events > (uint32_t)prep_block->decelerate_after) {
+        interval = calc_timer(decelerate_rate(deceleration_time), loops);
+        deceleration_time += interval;
       }
+      else
+        interval = OCR1A_nominal;
 
-      eISR_Rate = adv_rate(e_steps[TOOL_E_INDEX], timer, step_loops);
+      if (prep_step_events >= prep_block->step_event_count || aborted_block == prep_block) {
+        SBI(flag, STEP_EVENT_BIT_END);
+        prep_block = NULL;
+      }
+
+      step_ring[head].interval = interval;
+      step_ring[head].step_bits = step_bits;
+      step_ring[head].flag = flag;
 
-    #endif // ENABLED(LIN_ADVANCE)
+      // Publish the event to the stepper ISR
+      head = STEP_RING_MOD(head + 1);
+      step_ring_head = head;
+    }
   }
-  else {
 
-    #if ENABLED(LIN_ADVANCE)
+  /**
+   * Stepper ISR with the step ring
+   *
+   * Pulses the axes of one step event and schedules the next one after
+   * the precomputed interval. The timer restarts on the compare match,
+   * so the steps keep their spacing whatever the latency of the ISR.
+   */
+  void Stepper::ring_isr() {
 
-      if (current_block->use_advance_lead)
-        current_estep_rate[TOOL_E_INDEX] = final_estep_rate;
+    CYCLE_PROBE(STEPPER_ISR);
 
-      eISR_Rate = adv_rate(e_steps[TOOL_E_INDEX], OCR1A_nominal, step_loops_nominal);
+    if (cleaning_buffer_counter) {
+      --cleaning_buffer_counter;
+      current_block = NULL;
+      planner.discard_current_block();
+      #if ENABLED(SD_FINISHED_RELEASECOMMAND)
+        if (!cleaning_buffer_counter && (SD_FINISHED_STEPPERRELEASE)) commands.enqueue_and_echo_commands_P(PSTR(SD_FINISHED_RELEASECOMMAND));
+      #endif
+      _NEXT_ISR(HAL_STEPPER_TIMER_RATE / 10000); // Run at max speed - 10 KHz
+      return;
+    }
 
+    #if DISABLED(ENDSTOP_INTERRUPTS_FEATURE)
+      // Sample the endstops in between slow step events
+      static hal_timer_t step_remaining = 0;
+      if (step_remaining) {
+        if (ENDSTOPS_ENABLED) endstops.update();
+        const hal_timer_t ocr_val = step_remaining > ENDSTOP_NOMINAL_OCR_VAL ? ENDSTOP_NOMINAL_OCR_VAL : step_remaining;
+        step_remaining -= ocr_val;
+        _NEXT_ISR(ocr_val);
+        return;
+      }
     #endif
 
-    SPLIT(OCR1A_nominal); // split step into multiple ISRs if larger than ENDSTOP_NOMINAL_OCR_VAL
-    _NEXT_ISR(ocr_val);
+    uint16_t tail = step_ring_tail;
 
-    // ensure we're running at the correct step rate, even if we just came off an acceleration
-    step_loops = step_loops_nominal;
-  }
+    if (tail == step_ring_head) {
+      // The ring is empty, look again sooner if a block is not finished
+      _NEXT_ISR(current_block ? HAL_STEPPER_TIMER_RATE / 20000 : HAL_STEPPER_TIMER_RATE / 1000);
+      return;
+    }
 
-  #if DISABLED(LIN_ADVANCE)
-    #if ENABLED(CPU_32_BIT)
-      hal_timer_t stepper_timer_count = HAL_timer_get_count(STEPPER_TIMER);
-      NOLESS(stepper_timer_count, (HAL_timer_get_current_count(STEPPER_TIMER) + 8 * STEPPER_TIMER_TICKS_PER_US));
-      HAL_TIMER_SET_STEPPER_COUNT(stepper_timer_count);
+    if (TEST(step_ring[tail].flag, STEP_EVENT_BIT_START)) {
+      // The blocks before it are discarded, so it's at the tail of the planner
+      current_block = &planner.block_buffer[planner.block_buffer_tail];
+
+      set_block_directions();
+
+      #if ENABLED(ENDSTOP_INTERRUPTS_FEATURE)
+        endstops.e_hit = 2; // Needed for the case an endstop is already triggered before the new move begins.
+                            // No 'change' can be detected.
+      #endif
+    }
+
+    // Update endstops state, if enabled
+    #if ENABLED(ENDSTOP_INTERRUPTS_FEATURE)
+      if (endstops.e_hit && ENDSTOPS_ENABLED) {
+        endstops.update();
+        endstops.e_hit--;
+      }
     #else
-      NOLESS(OCR1A, TCNT1 + 16);
+      if (ENDSTOPS_ENABLED) endstops.update();
     #endif
-  #endif
 
-  // If current block is finished, reset pointer
-  if (all_steps_done) {
-    current_block = NULL;
-    planner.discard_current_block();
+    hal_timer_t interval;
 
-    #if ENABLED(ARDUINO_ARCH_SAM)
-      #if ENABLED(LASER)
-        laser.extinguish();
+    if (aborted_block) {
+      // Drop the step events left of the block aborted by an endstop
+      while (!TEST(step_ring[tail].flag, STEP_EVENT_BIT_END)) {
+        tail = STEP_RING_MOD(tail + 1);
+        if (tail == step_ring_head) {
+          step_ring_tail = tail;
+          _NEXT_ISR(HAL_STEPPER_TIMER_RATE / 20000);
+          return;
+        }
+      }
+      aborted_block = NULL;
+      interval = HAL_STEPPER_TIMER_RATE / 20000;
+    }
+    else {
+      const uint8_t step_bits = step_ring[tail].step_bits;
+      interval = step_ring[tail].interval;
+
+      #define RING_PULSE_START(AXIS) \
+        if (TEST(step_bits, AXIS ##_AXIS)) _APPLY_STEP(AXIS)(!_INVERT_STEP_PIN(AXIS),0)
+
+      #define RING_PULSE_STOP(AXIS) \
+        if (TEST(step_bits, AXIS ##_AXIS)) { \
+          machine_position[AXIS ##_AXIS] += count_direction[AXIS ##_AXIS]; \
+          _APPLY_STEP(AXIS)(_INVERT_STEP_PIN(AXIS),0); \
+        }
+
+      // If a minimum pulse time was specified get the CPU clock
+      #if EXTRA_CYCLES_XYZE > 20
+        const uint32_t pulse_start = HAL_timer_get_current_count(STEPPER_TIMER);
       #endif
-    #else
-      #if ENABLED(LASER) && ENABLED(LASER_PULSE_METHOD)
-        if (current_block->laser_mode == CONTINUOUS && current_block->laser_status == LASER_ON)
-          laser.extinguish();
+
+      #if HAS_X_STEP
+        RING_PULSE_START(X);
+      #endif
+      #if HAS_Y_STEP
+        RING_PULSE_START(Y);
       #endif
+      #if HAS_Z_STEP
+        RING_PULSE_START(Z);
+      #endif
+      #if HAS_EXTRUDERS
+        RING_PULSE_START(E);
+      #endif
+
+      // For a minimum pulse time wait before stopping pulses
+      #if EXTRA_CYCLES_XYZE > 20
+        while (EXTRA_CYCLES_XYZE > (uint32_t)(HAL_timer_get_current_count(STEPPER_TIMER) - pulse_start) * STEPPER_TIMER_PRESCALE) { /* noop */ }
+      #elif EXTRA_CYCLES_XYZE > 0
+        DELAY_NOPS(EXTRA_CYCLES_XYZE);
+      #endif
+
+      #if HAS_X_STEP
+        RING_PULSE_STOP(X);
+      #endif
+      #if HAS_Y_STEP
+        RING_PULSE_STOP(Y);
+      #endif
+      #if HAS_Z_STEP
+        RING_PULSE_STOP(Z);
+      #endif
+      #if HAS_EXTRUDERS
+        RING_PULSE_STOP(E);
+      #endif
+    }
+
+    // If current block is finished, reset pointer
+    if (TEST(step_ring[tail].flag, STEP_EVENT_BIT_END)) {
+      #if ENABLED(MOTION_STATS)
+        motionstats.block_done(current_block->step_event_count);
+      #endif
+      current_block = NULL;
+      planner.discard_current_block();
+    }
+
+    step_ring_tail = STEP_RING_MOD(tail + 1);
+
+    #if DISABLED(ENDSTOP_INTERRUPTS_FEATURE)
+      if (ENDSTOPS_ENABLED && interval > ENDSTOP_NOMINAL_OCR_VAL) {
+        step_remaining = interval - ENDSTOP_NOMINAL_OCR_VAL;
+        interval = ENDSTOP_NOMINAL_OCR_VAL;
+      }
     #endif
+
+    _NEXT_ISR(interval);
+
+    // The events are closer than the 8us of the stepper ISR, so only avoid
+    // setting the compare below the counter
+    hal_timer_t stepper_timer_count = HAL_timer_get_count(STEPPER_TIMER);
+    NOLESS(stepper_timer_count, (HAL_timer_get_current_count(STEPPER_TIMER) + STEPPER_TIMER_TICKS_PER_US));
+    HAL_TIMER_SET_STEPPER_COUNT(stepper_timer_count);
   }
 
-  #if DISABLED(LIN_ADVANCE)
-    HAL_ENABLE_ISRs(); // re-enable ISRs
-  #endif
-}
+#endif // STEPPER_RING
 
 #if ENABLED(LIN_ADVANCE)
 
   // Timer interrupt for E. e_steps is set in the main routine;
   void Stepper::advance_isr() {
 
+    CYCLE_PROBE(ADVANCE_ISR);
+
     nextAdvanceISR = eISR_Rate;
 
     #define SET_E_STEP_DIR(INDEX) \
@@ -1399,6 +1754,10 @@ void Stepper::init() {
   HAL_STEPPER_TIMER_START();
   ENABLE_STEPPER_INTERRUPT();
 
+  #if ENABLED(ARDUINO_ARCH_SAM)
+    HAL_STEPPER_PREP_TIMER_START();
+  #endif
+
   #if ENABLED(LIN_ADVANCE)
     for (uint8_t e = 0; e < COUNT(e_steps); e++) e_steps[e] = 0;
     ZERO(current_adv_steps);
@@ -1555,7 +1914,17 @@ void Stepper::quick_stop() {
       cleaning_buffer_counter = 5000;
 
   DISABLE_STEPPER_INTERRUPT();
-  while (planner.blocks_queued()) planner.discard_current_block();
+  // Keep the step preparation out while everything is flushed
+  CRITICAL_SECTION_START
+    while (planner.blocks_queued()) planner.discard_current_block();
+    #if ENABLED(STEPPER_RING)
+      step_ring_tail = step_ring_head;
+    #else
+      segment_tail = segment_head;
+      current_segment = NULL;
+    #endif
+    prep_block = aborted_block = NULL;
+  CRITICAL_SECTION_END
   current_block = NULL;
   ENABLE_STEPPER_INTERRUPT();
   #if ENABLED(ULTRA_LCD)
@@ -49,6 +49,43 @@
 
 #include "stepper_indirection.h"
 
+#if ENABLED(STEPPER_RING)
+
+  enum StepEventFlagBit {
+    STEP_EVENT_BIT_START, // First step event of a block
+    STEP_EVENT_BIT_END    // Last step event of a block
+  };
+
+  // A step event computed ahead into the step ring
+  typedef struct {
+    hal_timer_t interval;   // Timer ticks from this step event to the next one
+    uint8_t     step_bits,  // Axes to step, one bit for axis
+                flag;       // Block start and end bits
+  } step_event_t;
+
+#else
+
+  // Segments of about 1ms at a constant step rate, prepared ahead of the stepper ISR
+  #define SEGMENT_BUFFER_SIZE 8
+  #define SEGMENT_TICKS       ((uint32_t)((HAL_STEPPER_TIMER_RATE) / 1000))
+
+  enum SegmentFlagBit {
+    SEGMENT_BIT_START,  // First segment of a block
+    SEGMENT_BIT_END     // Last segment of a block
+  };
+
+  typedef struct {
+    hal_timer_t interval;     // Timer ticks between two stepper ISRs
+    uint16_t    n_step;       // Step events in the segment
+    uint8_t     step_loops,   // Step events for each stepper ISR
+                flag;         // Block start and end bits
+    #if ENABLED(LIN_ADVANCE)
+      hal_timer_t step_rate;  // Step rate of the segment, for the advance rate
+    #endif
+  } segment_t;
+
+#endif
+
 class Stepper {
 
   public: /** Constructor */
@@ -90,6 +127,24 @@ class Stepper {
     static long counter_X, counter_Y, counter_Z, counter_E;
     static volatile uint32_t step_events_completed; // The number of step events executed in the current block
 
+    static block_t* volatile aborted_block;         // The block aborted by an endstop, if any
+
+    #if ENABLED(STEPPER_RING)
+      static volatile step_event_t step_ring[STEPPER_RING_SIZE];
+      static volatile uint16_t  step_ring_head,   // Index of the next step event to be computed
+                                step_ring_tail;   // Index of the next step event to be pulsed
+    #else
+      static volatile segment_t segment_buffer[SEGMENT_BUFFER_SIZE];
+      static volatile uint8_t segment_head,       // Index of the next segment to be prepared
+                              segment_tail;       // Index of the segment being stepped
+      static volatile segment_t* current_segment; // The segment being stepped, if any
+      static uint16_t segment_steps_left;         // Step events left in the current segment
+    #endif
+
+    // The block being prepared, ahead of the stepper ISR
+    static block_t* prep_block;
+    static uint32_t prep_step_events;               // The number of step events prepared of prep_block
+
     #if ENABLED(LIN_ADVANCE)
 
       static hal_timer_t nextMainISR, nextAdvanceISR, eISR_Rate;
@@ -97,8 +152,7 @@ class Stepper {
 
       static volatile int e_steps[DRIVER_EXTRUDERS];
 
-      static int  final_estep_rate,
-                  current_estep_rate[DRIVER_EXTRUDERS], // Actual extruder speed [steps/s]
+      static int  current_estep_rate[DRIVER_EXTRUDERS], // Actual extruder speed [steps/s]
                   current_adv_steps[DRIVER_EXTRUDERS];  // The amount of current added esteps due to advance.
                                                         // i.e., the current amount of pressure applied
                                                         // to the spring (=filament).
@@ -107,12 +161,13 @@ class Stepper {
       #define _NEXT_ISR(T) HAL_TIMER_SET_STEPPER_COUNT(T);
     #endif // LIN_ADVANCE
 
+    // Acceleration ramp of the block being prepared
     static long acceleration_time, deceleration_time;
-    // unsigned long accelerate_until, decelerate_after, acceleration_rate, initial_rate, final_rate, nominal_rate;
     static hal_timer_t acc_step_rate, // needed for deceleration start point
                           OCR1A_nominal;
+    static uint8_t step_loops_nominal;
 
-    static uint8_t  step_loops, step_loops_nominal;
+    static uint8_t step_loops;        // Step events for each stepper ISR
 
     static volatile long endstops_trigsteps[XYZ];
 
@@ -157,7 +212,13 @@ class Stepper {
     //
     // Interrupt Service Routines
     //
-    static void isr();
+    #if ENABLED(STEPPER_RING)
+      static void ring_isr();
+      static void fill_step_ring();
+    #else
+      static void isr();
+      static void prepare_segments();
+    #endif
 
     #if ENABLED(LIN_ADVANCE)
       static void advance_isr();
@@ -262,7 +323,11 @@ class Stepper {
     #endif
 
     static inline void kill_current_block() {
-      step_events_completed = current_block->step_event_count;
+      // The stepper ISR drops what is left of the block, the preparation stops on it
+      aborted_block = current_block;
+      #if DISABLED(STEPPER_RING)
+        step_events_completed = current_block->step_event_count;
+      #endif
     }
 
     //
@@ -287,29 +352,76 @@ class Stepper {
 
   private: /** Private Function */
 
-    static FORCE_INLINE hal_timer_t calc_timer(hal_timer_t step_rate) {
+    #if ENABLED(S_CURVE_ACCELERATION)
+
+      /**
+       * Rate change at the given time of an S-curve ramp of delta_rate.
+       * The speed follows 10t^3 - 15t^4 + 6t^5, with t from 0 to 1, the
+       * derivative of a 6th order Bezier curve for the position, so the
+       * acceleration starts and ends at zero.
+       * t and its powers are Q32 on 32 bit CPUs and Q16 on AVR.
+       */
+      static FORCE_INLINE hal_timer_t eval_bezier_curve(const uint32_t time, const uint32_t time_inverse, const hal_timer_t delta_rate) {
+
+        #if ENABLED(CPU_32_BIT)
+
+          const uint32_t t  = time * time_inverse,
+                         t2 = ((uint64_t)t  * t) >> 32,
+                         t3 = ((uint64_t)t2 * t) >> 32,
+                         t4 = ((uint64_t)t3 * t) >> 32,
+                         t5 = ((uint64_t)t4 * t) >> 32;
+
+          int64_t curve = (int64_t)10 * t3 - (int64_t)15 * t4 + (int64_t)6 * t5;
+          NOLESS(curve, 0);
+          NOMORE(curve, 0x100000000LL);
+          return ((uint64_t)delta_rate * curve) >> 32;
+
+        #else
+
+          const uint16_t t  = (time * time_inverse) >> 16,
+                         t2 = ((uint32_t)t  * t + 0x8000) >> 16,
+                         t3 = ((uint32_t)t2 * t + 0x8000) >> 16,
+                         t4 = ((uint32_t)t3 * t + 0x8000) >> 16,
+                         t5 = ((uint32_t)t4 * t + 0x8000) >> 16;
+
+          int32_t curve = (int32_t)10 * t3 - (int32_t)15 * t4 + (int32_t)6 * t5;
+          NOLESS(curve, 0);
+          NOMORE(curve, 65536);
+          return ((uint32_t)delta_rate * curve) >> 16;
+
+        #endif
+      }
+
+    #endif
+
+    static FORCE_INLINE hal_timer_t calc_timer(hal_timer_t step_rate, uint8_t &loops) {
       hal_timer_t timer;
 
       NOMORE(step_rate, MAX_STEP_FREQUENCY);
 
-      #if ENABLED(DISABLE_DOUBLE_QUAD_STEPPING)
-        step_loops = 1;
+      #if ENABLED(DISABLE_DOUBLE_QUAD_STEPPING) || ENABLED(STEPPER_RING)
+        loops = 1;
       #else
         if (step_rate > (2 * DOUBLE_STEP_FREQUENCY)) { // If steprate > (2 * DOUBLE_STEP_FREQUENCY) Hz >> step 4 times
           step_rate >>= 2;
-          step_loops = 4;
+          loops = 4;
         }
         else if (step_rate > DOUBLE_STEP_FREQUENCY) { // If steprate > DOUBLE_STEP_FREQUENCY >> step 2 times
           step_rate >>= 1;
-          step_loops = 2;
+          loops = 2;
         }
         else
-          step_loops = 1;
+          loops = 1;
       #endif
 
       #if ENABLED(CPU_32_BIT)
         // In case of high-performance processor, it is able to calculate in real-time
-        constexpr uint32_t MIN_TIME_PER_STEP = (HAL_STEPPER_TIMER_RATE) / ((DOUBLE_STEP_FREQUENCY) * 2);
+        #if ENABLED(STEPPER_RING)
+          // Every step has its own interrupt
+          constexpr uint32_t MIN_TIME_PER_STEP = (HAL_STEPPER_TIMER_RATE) / (MAX_STEP_FREQUENCY);
+        #else
+          constexpr uint32_t MIN_TIME_PER_STEP = (HAL_STEPPER_TIMER_RATE) / ((DOUBLE_STEP_FREQUENCY) * 2);
+        #endif
         timer = (uint32_t)HAL_STEPPER_TIMER_RATE / step_rate;
         NOLESS(timer, MIN_TIME_PER_STEP);
       #else
@@ -338,9 +450,55 @@ class Stepper {
       return timer;
     }
 
-    // Initializes the trapezoid generator from the current block. Called whenever a new
-    // block begins.
+    // Initializes the trapezoid generator from the block being prepared. Called whenever
+    // the preparation takes a new block.
     static FORCE_INLINE void trapezoid_generator_reset() {
+      prep_step_events = 0;
+      acceleration_time = deceleration_time = 0;
+      // step_rate to timer interval
+      OCR1A_nominal = calc_timer(prep_block->nominal_rate, step_loops_nominal);
+      acc_step_rate = prep_block->initial_rate;
+    }
+
+    // Step rate at the given time of the acceleration of the block being prepared
+    static FORCE_INLINE hal_timer_t accelerate_rate(const uint32_t time) {
+      hal_timer_t step_rate;
+      #if ENABLED(S_CURVE_ACCELERATION)
+        // Jerk limited rate on the S-curve, the ramp ends at the cruise rate
+        step_rate = time < prep_block->acceleration_time
+          ? prep_block->initial_rate + eval_bezier_curve(time, prep_block->acceleration_time_inverse, prep_block->cruise_rate - prep_block->initial_rate)
+          : prep_block->cruise_rate;
+      #else
+        HAL_MULTI_ACC(step_rate, time, prep_block->acceleration_rate);
+        step_rate += prep_block->initial_rate;
+        // upper limit
+        NOMORE(step_rate, prep_block->nominal_rate);
+      #endif
+      return step_rate;
+    }
+
+    // Step rate at the given time of the deceleration of the block being prepared
+    static FORCE_INLINE hal_timer_t decelerate_rate(const uint32_t time) {
+      hal_timer_t step_rate;
+      #if ENABLED(S_CURVE_ACCELERATION)
+        // Jerk limited rate on the S-curve from the cruise rate down to the final rate
+        step_rate = time < prep_block->deceleration_time
+          ? prep_block->cruise_rate - eval_bezier_curve(time, prep_block->deceleration_time_inverse, prep_block->cruise_rate - prep_block->final_rate)
+          : prep_block->final_rate;
+      #else
+        HAL_MULTI_ACC(step_rate, time, prep_block->acceleration_rate);
+        if (step_rate < acc_step_rate) {
+          step_rate = acc_step_rate - step_rate; // Decelerate from acceleration end point.
+          NOLESS(step_rate, prep_block->final_rate);
+        }
+        else
+          step_rate = prep_block->final_rate;
+      #endif
+      return step_rate;
+    }
+
+    // Set the directions of a new block in the stepper ISR
+    static FORCE_INLINE void set_block_directions() {
 
       static int8_t last_extruder = -1;
 
@@ -348,23 +506,10 @@ class Stepper {
         last_direction_bits = current_block->direction_bits;
         last_extruder = current_block->active_extruder;
         set_directions();
+        #if STEPPER_DIRECTION_DELAY > 0
+          HAL::delayMicroseconds(STEPPER_DIRECTION_DELAY);
+        #endif
       }
-
-      deceleration_time = 0;
-      // step_rate to timer interval
-      OCR1A_nominal = calc_timer(current_block->nominal_rate);
-      // make a note of the number of step loops required at nominal speed
-      step_loops_nominal = step_loops;
-      acc_step_rate = current_block->initial_rate;
-      acceleration_time = calc_timer(acc_step_rate);
-      _NEXT_ISR(acceleration_time);
-
-      #if ENABLED(LIN_ADVANCE)
-        if (current_block->use_advance_lead) {
-          current_estep_rate[current_block->active_extruder] = ((unsigned long)acc_step_rate * current_block->abs_adv_steps_multiplier8) >> 17;
-          final_estep_rate = (current_block->nominal_rate * current_block->abs_adv_steps_multiplier8) >> 17;
-        }
-      #endif
     }
 
     static void digipot_init();
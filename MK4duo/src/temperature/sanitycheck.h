@@ -156,6 +156,48 @@
     #error DEPENDENCY ERROR: Missing setting DEFAULT_Kd
   #endif
 #endif
+#if ENABLED(TEMP_TELEMETRY)
+  #if HEATER_COUNT == 0
+    #error DEPENDENCY ERROR: TEMP_TELEMETRY requires at least one heater
+  #endif
+  #if !WITHIN(TEMP_TELEMETRY_SAMPLES, 8, 2000)
+    #error DEPENDENCY ERROR: TEMP_TELEMETRY_SAMPLES must be from 8 to 2000
+  #endif
+  #if DISABLED(TEMP_TELEMETRY_FILE)
+    #error DEPENDENCY ERROR: Missing setting TEMP_TELEMETRY_FILE
+  #endif
+#endif
+#if ENABLED(MPC_HOTEND)
+  #if !(PIDTEMP)
+    #error DEPENDENCY ERROR: MPC_HOTEND requires PIDTEMP
+  #endif
+  #if ENABLED(PID_ADD_EXTRUSION_RATE)
+    #error CONFLICT ERROR: MPC_HOTEND and PID_ADD_EXTRUSION_RATE cannot be enabled together
+  #endif
+  #if DISABLED(MPC_HEATER_POWER) || DISABLED(MPC_BLOCK_HEAT_CAPACITY) || DISABLED(MPC_AMBIENT_XFER_COEFF) || DISABLED(MPC_AMBIENT_XFER_COEFF_FAN) || DISABLED(MPC_FILAMENT_HEAT_CAPACITY_PERMM)
+    #error DEPENDENCY ERROR: Missing MPC_HOTEND model settings
+  #endif
+  #if DISABLED(MPC_LOOKAHEAD_TIME) || DISABLED(MPC_SMOOTHING_FACTOR) || DISABLED(MPC_AMBIENT_GAIN)
+    #error DEPENDENCY ERROR: Missing MPC_HOTEND control settings
+  #endif
+  #if MPC_FAN_INDEX >= FAN_COUNT
+    #error DEPENDENCY ERROR: MPC_FAN_INDEX must be a valid fan or -1
+  #endif
+#endif
+#if ENABLED(HEATER_CONTROL_SCHEDULER)
+  #if !HAS_PID
+    #error DEPENDENCY ERROR: HEATER_CONTROL_SCHEDULER requires a PID heater
+  #endif
+  #if ENABLED(PID_ADD_EXTRUSION_RATE)
+    #error CONFLICT ERROR: HEATER_CONTROL_SCHEDULER and PID_ADD_EXTRUSION_RATE cannot be enabled together
+  #endif
+  #if DISABLED(HOTEND_CONTROL_PERIOD) || DISABLED(BED_CONTROL_PERIOD) || DISABLED(CHAMBER_CONTROL_PERIOD) || DISABLED(COOLER_CONTROL_PERIOD)
+    #error DEPENDENCY ERROR: Missing HEATER_CONTROL_SCHEDULER period settings
+  #endif
+  #if !WITHIN(HOTEND_CONTROL_PERIOD, 10, 5000) || !WITHIN(BED_CONTROL_PERIOD, 10, 5000) || !WITHIN(CHAMBER_CONTROL_PERIOD, 10, 5000) || !WITHIN(COOLER_CONTROL_PERIOD, 10, 5000)
+    #error CONFLICT ERROR: Heater control periods must be between 10 and 5000 ms
+  #endif
+#endif
 #if (PIDTEMPBED)
   #if !HAS_TEMP_BED
     #error DEPENDENCY ERROR: Missing setting TEMP_SENSOR_BED
@@ -34,6 +34,10 @@ constexpr bool      thermal_protection[HEATER_TYPE]   = { THERMAL_PROTECTION_HOT
 // public:
 volatile bool Temperature::wait_for_heatup = true;
 
+#if ENABLED(ASYNC_HEATER_WAIT)
+  bool Temperature::async_wait = true;
+#endif
+
 #if HAS_MCU_TEMPERATURE
   float   Temperature::mcu_current_temperature  = 0.0,
           Temperature::mcu_highest_temperature  = 0.0,
@@ -68,10 +72,18 @@ uint8_t Temperature::cycle_1_second = 0;
         Temperature::lpq_len = 20;
 #endif
 
+#if ENABLED(MPC_HOTEND)
+  float Temperature::mpc_e_rate[HOTENDS] = { 0.0 };
+#endif
+
 uint8_t Temperature::pid_pointer[HEATER_COUNT] = { 0 };
 
 millis_t Temperature::next_check_ms[HEATER_COUNT];
 
+#if ENABLED(HEATER_CONTROL_SCHEDULER)
+  millis_t Temperature::last_control_ms[HEATER_COUNT] = { 0 };
+#endif
+
 #if ENABLED(FILAMENT_SENSOR)
   int8_t    Temperature::meas_shift_index;          // Index of a delayed sample in buffer
   uint16_t  Temperature::current_raw_filwidth = 0;  // Measured filament diameter - one extruder only
@@ -81,6 +93,11 @@ millis_t Temperature::next_check_ms[HEATER_COUNT];
   bool Temperature::paused;
 #endif
 
+#if ENABLED(ASYNC_HEATER_WAIT)
+  uint8_t Temperature::wait_pending = 0,
+          Temperature::wait_cooling = 0;
+#endif
+
 // Public Function
 
 /**
@@ -223,6 +240,39 @@ void Temperature::wait_heater(Heater *act, bool no_wait_for_cooling/*=true*/) {
   #endif
 }
 
+void Temperature::wait_heater_command(Heater *act, const bool no_wait_for_cooling) {
+
+  #if ENABLED(ASYNC_HEATER_WAIT)
+    if (async_wait) {
+      const uint8_t h = act - heaters;
+      SBI(wait_pending, h);
+      if (no_wait_for_cooling) CBI(wait_cooling, h); else SBI(wait_cooling, h);
+      return;
+    }
+  #endif
+
+  wait_heater(act, no_wait_for_cooling);
+}
+
+#if ENABLED(ASYNC_HEATER_WAIT)
+
+  /**
+   * Barrier: wait for all the heaters with a deferred wait.
+   * An M108 drops the waits not done yet.
+   */
+  void Temperature::wait_pending_heaters() {
+    LOOP_HEATER() {
+      if (TEST(wait_pending, h)) {
+        CBI(wait_pending, h);
+        wait_heater(&heaters[h], !TEST(wait_cooling, h));
+        if (!wait_for_heatup) break;
+      }
+    }
+    wait_pending = wait_cooling = 0;
+  }
+
+#endif // ASYNC_HEATER_WAIT
+
 void Temperature::set_current_temp_raw() {
 
   #if ANALOG_INPUTS > 0
@@ -251,12 +301,18 @@ void Temperature::set_current_temp_raw() {
  */
 void Temperature::spin() {
 
+  CYCLE_PROBE(TEMP_SPIN);
+
   if (++cycle_1_second == 10) cycle_1_second = 0;
 
   updateTemperaturesFromRawValues();
 
   millis_t ms = millis();
 
+  #if ENABLED(MPC_HOTEND)
+    calc_mpc_e_rate();
+  #endif
+
   LOOP_HEATER() {
 
     Heater *act = &heaters[h];
@@ -275,8 +331,11 @@ void Temperature::spin() {
         thermal_runaway_protection(&thermal_runaway_state_machine[h], &thermal_runaway_timer[h], act->current_temperature, act->target_temperature, h, THERMAL_PROTECTION_PERIOD, THERMAL_PROTECTION_HYSTERESIS);
     #endif
 
-    if (act->use_pid)
-      act->soft_pwm = act->tempisrange() ? get_pid_output(h) : 0;
+    if (act->use_pid) {
+      #if DISABLED(HEATER_CONTROL_SCHEDULER) // Else the output is set by control()
+        act->soft_pwm = act->tempisrange() ? get_pid_output(h) : 0;
+      #endif
+    }
     else if (ELAPSED(ms, next_check_ms[h])) {
       next_check_ms[h] = ms + temp_check_interval[act->type];
       if (act->tempisrange())
@@ -311,220 +370,93 @@ void Temperature::spin() {
       tools.refresh_e_factor(FILAMENT_SENSOR_EXTRUDER_NUM);
     }
   #endif // FILAMENT_SENSOR
-}
-
-/**
- * PID Autotuning (M303)
- *
- * Alternately heat and cool the nozzle, observing its behavior to
- * determine the best PID values to achieve a stable temperature.
- */
-void Temperature::PID_autotune(Heater *act, const float temp, const uint8_t ncycles, const uint8_t method, const bool storeValues/*=false*/) {
-
-  float currentTemp = 0.0;
-  int cycles = 0;
-  bool heating = true;
-
-  millis_t next_temp_ms = millis(), t1 = next_temp_ms, t2 = next_temp_ms;
-  int32_t t_high = 0, t_low = 0;
-
-  int32_t bias, d;
-  float Ku, Tu,
-        workKp = 0, workKi = 0, workKd = 0,
-        maxTemp = 0.0, minTemp = 10000.0;
-
-  disable_all_heaters(); // switch off all heaters.
-
-  const uint8_t pidMax = act->pid_max;
-  act->soft_pwm = pidMax;
 
-  bias = pidMax >> 1;
-  d = pidMax >> 1;
+  #if ENABLED(TEMP_TELEMETRY)
+    telemetry.sample();
+  #endif
+}
 
-  wait_for_heatup = true;
+#if ENABLED(HEATER_CONTROL_SCHEDULER)
 
-  // PID Tuning loop
-  while (wait_for_heatup) {
+  /**
+   * Heater control scheduler:
+   *  - Every PID heater has its own control period
+   *  - Read the sensor of the heater and compute the output
+   *    with the time really elapsed since the last run
+   *  - Hardware PWM is updated at once instead of at the next 100ms tick
+   * Safety checks stay in spin().
+   */
+  void Temperature::control() {
 
     const millis_t ms = millis();
 
-    updateTemperaturesFromRawValues();
-
-    #if FAN_COUNT > 0
-      LOOP_FAN() fans[f].Check();
-    #endif
-
-    currentTemp = act->current_temperature;
-
-    NOLESS(maxTemp, currentTemp);
-    NOMORE(minTemp, currentTemp);
-
-    if (heating && currentTemp > temp) {
-      if (ELAPSED(ms, t2 + 2500UL)) {
-        heating = false;
+    LOOP_HEATER() {
 
-        act->soft_pwm = (bias - d);
+      Heater *act = &heaters[h];
 
-        t1 = ms;
-        t_high = t1 - t2;
+      if (!act->use_pid || PENDING(ms, last_control_ms[h] + act->control_period)) continue;
 
-        #if HAS_TEMP_COOLER
-          if (act->type == IS_COOLER)
-            minTemp = temp;
-          else
-        #endif
-          maxTemp = temp;
-      }
-    }
+      // Don't let a long stall look like a huge step
+      millis_t elapsed = ms - last_control_ms[h];
+      NOMORE(elapsed, 2UL * act->control_period);
+      last_control_ms[h] = ms;
 
-    if (!heating && currentTemp < temp) {
-      if (ELAPSED(ms, t1 + 5000UL)) {
-        heating = true;
-        t2 = ms;
-        t_low = t2 - t1;
-        if (cycles > 0) {
-
-          bias += (d * (t_high - t_low)) / (t_low + t_high);
-          bias = constrain(bias, 20, pidMax - 20);
-          d = (bias > pidMax / 2) ? pidMax - 1 - bias : bias;
-
-          SERIAL_MV(MSG_BIAS, bias);
-          SERIAL_MV(MSG_D, d);
-          SERIAL_MV(MSG_T_MIN, minTemp);
-          SERIAL_EMV(MSG_T_MAX, maxTemp);
-          if (cycles > 2) {
-            Ku = (4.0 * d) / (M_PI * (maxTemp - minTemp));
-            Tu = ((float)(t_low + t_high) * 0.001);
-            SERIAL_MV(MSG_KU, Ku);
-            SERIAL_EMV(MSG_TU, Tu);
-
-            if (method == 0) {
-              workKp = 0.6 * Ku;
-              workKi = 2.0 * workKp / Tu;
-              workKd = workKp * Tu * 0.125;
-              SERIAL_EM(MSG_CLASSIC_PID);
-            }
-            else if (method == 1) {
-              workKp = 0.33 * Ku;
-              workKi = 2.0 * workKp / Tu;
-              workKd = workKp * Tu / 3.0;
-              SERIAL_EM(MSG_SOME_OVERSHOOT_PID);
-            }
-            else if (method == 2) {
-              workKp = 0.2 * Ku;
-              workKi = 2.0 * workKp / Tu;
-              workKd = workKp * Tu / 3.0;
-              SERIAL_EM(MSG_NO_OVERSHOOT_PID);
-            }
-            else if (method == 3) {
-              workKp = 0.7 * Ku;
-              workKi = 2.5 * workKp / Tu;
-              workKd = workKp * Tu * 3.0 / 20.0;
-              SERIAL_EM(MSG_PESSEN_PID);
-            }
-            SERIAL_EMV(MSG_KP, workKp);
-            SERIAL_EMV(MSG_KI, workKi);
-            SERIAL_EMV(MSG_KD, workKd);
-          }
-        }
+      act->current_temperature = act->sensor.GetTemperature(h);
+      act->soft_pwm = act->tempisrange() ? get_pid_output(h, elapsed * 0.001) : 0;
 
-        act->soft_pwm = (bias + d);
-
-        cycles++;
-
-        #if HAS_TEMP_COOLER
-          if (act->type == IS_COOLER)
-            maxTemp = temp;
-          else
-        #endif
-          minTemp = temp;
-      }
-    }
-
-    #define MAX_OVERSHOOT_PID_AUTOTUNE 40
-    if (currentTemp > temp + MAX_OVERSHOOT_PID_AUTOTUNE
-      #if HAS_TEMP_COOLER
-        && act->type != IS_COOLER
+      #if HARDWARE_PWM
+        act->SetHardwarePwm();
       #endif
-    ) {
-      SERIAL_LM(ER, MSG_PID_TEMP_TOO_HIGH);
-      break;
-    }
-    #if HAS_TEMP_COOLER
-      else if (currentTemp < temp + MAX_OVERSHOOT_PID_AUTOTUNE && act->type == IS_COOLER) {
-        SERIAL_LM(ER, MSG_PID_TEMP_TOO_LOW);
-        break;
-      }
-    #endif
-
-    // Every 2 seconds...
-    if (ELAPSED(ms, next_temp_ms)) {
-      print_heaters_state();
-      SERIAL_EOL();
-      next_temp_ms = ms + 2000UL;
-    }
-
-    // Timeout after 20 minutes since the last undershoot/overshoot cycle
-    if (((ms - t1) + (ms - t2)) > (20L * 60L * 1000L)) {
-      SERIAL_EM(MSG_PID_TIMEOUT);
-      break;
     }
+  }
 
-    if (cycles > ncycles) {
-
-      SERIAL_EM(MSG_PID_AUTOTUNE_FINISHED);
+#endif // HEATER_CONTROL_SCHEDULER
 
-      #if (PIDTEMP)
-        if (act->type == IS_HOTEND) {
-          SERIAL_MV(MSG_KP, workKp);
-          SERIAL_MV(MSG_KI, workKi);
-          SERIAL_EMV(MSG_KD, workKd);
-        }
-      #endif
+/**
+ * PID Autotuning (M303)
+ *
+ * Alternately heat and cool the nozzle, observing its behavior to
+ * determine the best PID values to achieve a stable temperature.
+ */
+void Temperature::PID_autotune(Heater *act, const float temp, const uint8_t ncycles, const uint8_t method, const bool storeValues/*=false*/) {
 
-      #if (PIDTEMPBED)
-        if (act->type == IS_BED) {
-          SERIAL_EMV("#define DEFAULT_bedKp ", workKp);
-          SERIAL_EMV("#define DEFAULT_bedKi ", workKi);
-          SERIAL_EMV("#define DEFAULT_bedKd ", workKd);
-        }
-      #endif
+  #if ENABLED(MPC_HOTEND)
+    if (method == 4) {
+      MPC_autotune(act, temp, storeValues);
+      return;
+    }
+  #endif
 
-      #if (PIDTEMPCHAMBER)
-        if (act->type == IS_CHAMBER) {
-          SERIAL_EMV("#define DEFAULT_chamberKp ", workKp);
-          SERIAL_EMV("#define DEFAULT_chamberKi ", workKi);
-          SERIAL_EMV("#define DEFAULT_chamberKd ", workKd);
-        }
-      #endif
+  pid_tune_t tune;
+  tune_init(tune, act, temp);
+  tune_run(&tune, 1, ncycles, method, storeValues);
+}
 
-      #if (PIDTEMPCOOLER)
-        if (act->type == IS_COOLER) {
-          SERIAL_EMV("#define DEFAULT_coolerKp ", workKp);
-          SERIAL_EMV("#define DEFAULT_coolerKi ", workKi);
-          SERIAL_EMV("#define DEFAULT_coolerKd ", workKd);
-        }
-      #endif
+/**
+ * PID Autotuning of all the PID hotends, bed and chamber at the same time (M303 A)
+ *
+ * Every heater runs its own relay, a heater that finishes or fails
+ * is switched off while the others go on.
+ */
+void Temperature::PID_autotune_all(const float hotend_temp, const float bed_temp, const float chamber_temp, const uint8_t ncycles, const uint8_t method, const bool storeValues/*=false*/) {
 
-      if (storeValues) {
-        act->Kp = workKp;
-        act->Ki = workKi;
-        act->Kd = workKd;
-        updatePID();
-        eeprom.Store_Settings();
-      }
+  pid_tune_t tune[HEATER_COUNT];
+  uint8_t count = 0;
 
-      return;
+  LOOP_HEATER() {
+    if (!heaters[h].use_pid) continue;
+    switch (heaters[h].type) {
+      case IS_HOTEND:   tune_init(tune[count++], &heaters[h], hotend_temp);   break;
+      case IS_BED:      tune_init(tune[count++], &heaters[h], bed_temp);      break;
+      case IS_CHAMBER:  tune_init(tune[count++], &heaters[h], chamber_temp);  break;
+      default: break; // The cooler is tuned alone
     }
-
-    #if ENABLED(NEXTION)
-      lcd_key_touch_update();
-    #else
-      lcd_update();
-    #endif
-
   }
-  disable_all_heaters();
+
+  if (count)
+    tune_run(tune, count, ncycles, method, storeValues);
+  else
+    SERIAL_LM(ER, MSG_PID_BAD_TEMP_CONTROLLER_NUM);
 }
 
 void Temperature::updatePID() {
@@ -554,6 +486,10 @@ void Temperature::disable_all_heaters() {
     }
   #endif
 
+  #if ENABLED(ASYNC_HEATER_WAIT)
+    wait_pending = wait_cooling = 0;
+  #endif
+
   #if ENABLED(LASER)
     // No laser firing with no coolers running! (paranoia)
     laser.extinguish();
@@ -741,11 +677,15 @@ void Temperature::updateTemperaturesFromRawValues() {
   }
 #endif
 
-uint8_t Temperature::get_pid_output(const uint8_t h) {
+uint8_t Temperature::get_pid_output(const uint8_t h, const float dt/*=0.1*/) {
 
   static float  last_temperature[HEATER_COUNT]  = { 0.0 },
                 temperature_1s[HEATER_COUNT]    = { 0.0 };
 
+  #if ENABLED(MPC_HOTEND)
+    if (heaters[h].type == IS_HOTEND) return get_mpc_output(h, dt);
+  #endif
+
   uint8_t pid_output = 0;
 
   Heater *act = &heaters[h];
@@ -771,7 +711,7 @@ uint8_t Temperature::get_pid_output(const uint8_t h) {
   }
   else {
     float pidTerm = act->Kp * error;
-    act->tempIState = constrain(act->tempIState + error, act->tempIStateLimitMin, act->tempIStateLimitMax);
+    act->tempIState = constrain(act->tempIState + error * dt * 10.0, act->tempIStateLimitMin, act->tempIStateLimitMax); // I state in 100ms steps
     pidTerm += act->Ki * act->tempIState * 0.1; // 0.1 = 10Hz
     float dgain = act->Kd * (last_temperature[h] - temperature_1s[h]);
     pidTerm += dgain;
@@ -795,7 +735,16 @@ uint8_t Temperature::get_pid_output(const uint8_t h) {
 
     pid_output = constrain((int)pidTerm, 0, PID_MAX);
 
-    if (cycle_1_second == 0) {
+    // D term on the temperature change of one second
+    #if ENABLED(HEATER_CONTROL_SCHEDULER)
+      static millis_t next_1s_ms[HEATER_COUNT] = { 0 };
+      const bool sample_1s = ELAPSED(millis(), next_1s_ms[h]);
+      if (sample_1s) next_1s_ms[h] = millis() + 1000UL;
+    #else
+      const bool sample_1s = cycle_1_second == 0;
+    #endif
+
+    if (sample_1s) {
       last_temperature[h] = temperature_1s[h];
       temperature_1s[h] = act->current_temperature;
     }
@@ -811,6 +760,614 @@ uint8_t Temperature::get_pid_output(const uint8_t h) {
   return pid_output;
 }
 
+#if ENABLED(MPC_HOTEND)
+
+  /**
+   * Average forward extrusion speed (mm/s of filament) of each hotend
+   * over the next MPC_LOOKAHEAD_TIME seconds of the planner buffer.
+   * Block times are taken at nominal speed.
+   */
+  void Temperature::calc_mpc_e_rate() {
+
+    float e_mm[HOTENDS] = { 0.0 },
+          time_s = 0.0;
+
+    const uint8_t head = planner.block_buffer_head;
+    for (uint8_t b = planner.block_buffer_tail; b != head && time_s < MPC_LOOKAHEAD_TIME; b = planner.next_block_index(b)) {
+      const block_t * const block = &planner.block_buffer[b];
+      time_s += block->millimeters / block->nominal_speed;
+      if (block->steps[E_AXIS] && !TEST(block->direction_bits, E_AXIS)) {
+        #if HOTENDS > 1
+          const uint8_t h = block->active_extruder;
+          if (h >= HOTENDS) continue;
+        #else
+          constexpr uint8_t h = 0;
+        #endif
+        e_mm[h] += block->steps[E_AXIS] * mechanics.steps_to_mm[E_AXIS + block->active_extruder];
+      }
+    }
+
+    LOOP_HOTEND() mpc_e_rate[h] = time_s > 0.0 ? e_mm[h] / time_s : 0.0;
+  }
+
+  /**
+   * Model predictive control of a hotend
+   *
+   * The block is modelled as a single heat capacity fed by the heater and
+   * losing heat to the ambient (more with the part fan on) and to the filament
+   * passing through. Each period the model advances with the power applied in
+   * the last one and is pulled towards the sensor, the persistent part of the
+   * difference slowly moves the ambient estimate. The output is the power
+   * that brings the model to the target in one period plus the losses at target.
+   */
+  uint8_t Temperature::get_mpc_output(const uint8_t h, const float dt/*=0.1*/) {
+
+    // Smoothing factors are set for the 100ms spin period
+    float smoothing     = MPC_SMOOTHING_FACTOR * dt * 10.0,
+          ambient_gain  = MPC_AMBIENT_GAIN * dt * 10.0;
+    NOMORE(smoothing, 1.0);
+    NOMORE(ambient_gain, 1.0);
+
+    Heater *act = &heaters[h];
+
+    uint8_t mpc_output = 0;
+
+    #if MPC_FAN_INDEX >= 0
+      const float fan_speed = fans[MPC_FAN_INDEX].Speed * (1.0 / 255.0);
+    #else
+      constexpr float fan_speed = 0.0;
+    #endif
+
+    const float ambient_xfer  = act->mpc_ambient_xfer_coeff + fan_speed * (act->mpc_ambient_xfer_coeff_fan - act->mpc_ambient_xfer_coeff),
+                loss_coeff    = ambient_xfer + act->mpc_filament_heat_capacity * mpc_e_rate[h];
+
+    // Advance the model with the power of the last period
+    act->mpc_model_temp += (act->mpc_heater_power * act->soft_pwm * (1.0 / 255.0) - loss_coeff * (act->mpc_model_temp - act->mpc_ambient_temp)) * dt / act->mpc_block_heat_capacity;
+
+    const float error = act->current_temperature - act->mpc_model_temp;
+
+    if (act->target_temperature == 0
+      #if HEATER_IDLE_HANDLER
+        || act->is_idle()
+      #endif
+      || FABS(error) > PID_FUNCTIONAL_RANGE
+    ) {
+      act->mpc_model_temp = act->current_temperature;
+    }
+    else {
+      act->mpc_model_temp += error * smoothing;
+      if (FABS(act->target_temperature - act->current_temperature) < PID_FUNCTIONAL_RANGE) {
+        act->mpc_ambient_temp += error * ambient_gain;
+        act->mpc_ambient_temp = constrain(act->mpc_ambient_temp, 0, act->target_temperature);
+      }
+    }
+
+    if (act->target_temperature > 0
+      #if HEATER_IDLE_HANDLER
+        && !act->is_idle()
+      #endif
+    ) {
+      const float power = act->mpc_block_heat_capacity * (act->target_temperature - act->mpc_model_temp) / dt
+                        + loss_coeff * (act->target_temperature - act->mpc_ambient_temp);
+      mpc_output = constrain(LROUND(power * 255.0 / act->mpc_heater_power), 0, act->pid_max);
+    }
+
+    #if ENABLED(PID_DEBUG)
+      SERIAL_SMV(ECHO, MSG_PID_DEBUG, HOTEND_INDEX);
+      SERIAL_MV(MSG_PID_DEBUG_INPUT, act->current_temperature);
+      SERIAL_MV(" Model: ", act->mpc_model_temp);
+      SERIAL_MV(" Ambient: ", act->mpc_ambient_temp);
+      SERIAL_MV(" E rate: ", mpc_e_rate[h]);
+      SERIAL_EMV(MSG_PID_DEBUG_OUTPUT, mpc_output);
+    #endif
+
+    return mpc_output;
+  }
+
+  /**
+   * Hotend model autotuning (M303 R4)
+   *
+   * - Wait for the hotend to settle at ambient temperature, part fan on.
+   * - Heat at full power with the fan off and fit the heating curve with
+   *   an exponential through three equally spaced samples. The time constant
+   *   and the asymptote give heat capacity and losses for the configured
+   *   heater power.
+   * - Hold the target with the new model, first with the fan off then at
+   *   full speed, and take the losses from the average power.
+   */
+  void Temperature::MPC_autotune(Heater *act, const float temp, const bool storeValues) {
+
+    #define MPC_TUNE_SAMPLES 32
+
+    if (act->type != IS_HOTEND) {
+      SERIAL_LM(ER, "Model autotune is for hotends only");
+      return;
+    }
+
+    const uint8_t h = act - heaters;
+
+    enum MPCTuneState { MPCAmbient, MPCHeating, MPCSettle, MPCHoldFanOff, MPCHoldFanOn } state = MPCAmbient;
+
+    float samples[MPC_TUNE_SAMPLES],
+          ambient_temp    = act->current_temperature,
+          last_temp       = act->current_temperature,
+          sum_temp        = 0.0,
+          sum_power       = 0.0;
+    uint8_t sample_count  = 0;
+    uint16_t hold_ticks   = 0;
+    millis_t sample_interval = 1000UL;
+
+    const millis_t start_ms = millis();
+    millis_t next_temp_ms = start_ms, next_sample_ms = start_ms, next_tick_ms = start_ms, state_ms = start_ms;
+
+    const float old_power     = act->mpc_heater_power,
+                old_capacity  = act->mpc_block_heat_capacity,
+                old_xfer      = act->mpc_ambient_xfer_coeff,
+                old_xfer_fan  = act->mpc_ambient_xfer_coeff_fan;
+
+    // Heater power really delivered when the output is at pid_max
+    const float full_power = act->mpc_heater_power * act->pid_max * (1.0 / 255.0);
+
+    #if MPC_FAN_INDEX >= 0
+      const uint8_t old_fan_speed = fans[MPC_FAN_INDEX].Speed;
+      fans[MPC_FAN_INDEX].Speed = 255;
+    #endif
+
+    disable_all_heaters(); // switch off all heaters.
+
+    SERIAL_EM("Measuring ambient temperature");
+
+    bool tuned = false;
+
+    wait_for_heatup = true;
+
+    while (wait_for_heatup) {
+
+      const millis_t ms = millis();
+
+      updateTemperaturesFromRawValues();
+
+      #if FAN_COUNT > 0
+        LOOP_FAN() fans[f].Check();
+      #endif
+
+      const float currentTemp = act->current_temperature;
+
+      if (currentTemp > temp + MAX_OVERSHOOT_PID_AUTOTUNE) {
+        SERIAL_LM(ER, MSG_PID_TEMP_TOO_HIGH);
+        break;
+      }
+
+      // Every 2 seconds...
+      if (ELAPSED(ms, next_temp_ms)) {
+        print_heaters_state();
+        SERIAL_EOL();
+        next_temp_ms = ms + 2000UL;
+      }
+
+      if (ms - start_ms > (20L * 60L * 1000L)) {
+        SERIAL_EM(MSG_PID_TIMEOUT);
+        break;
+      }
+
+      switch (state) {
+
+        case MPCAmbient:
+          // Settled when the temperature moves less than 0.5C in 10 seconds
+          if (ELAPSED(ms, state_ms + 10000UL)) {
+            state_ms = ms;
+            if (FABS(last_temp - currentTemp) < 0.5) {
+              ambient_temp = currentTemp;
+              SERIAL_EMV("Ambient temperature: ", ambient_temp);
+              SERIAL_EM("Heating at full power");
+              #if MPC_FAN_INDEX >= 0
+                fans[MPC_FAN_INDEX].Speed = 0;
+              #endif
+              act->soft_pwm = act->pid_max;
+              next_sample_ms = ms;
+              state = MPCHeating;
+            }
+            last_temp = currentTemp;
+          }
+          break;
+
+        case MPCHeating:
+          if (ELAPSED(ms, next_sample_ms)) {
+            // Keep the whole curve in the buffer halving the resolution when full
+            if (sample_count == MPC_TUNE_SAMPLES) {
+              for (uint8_t i = 0; i < MPC_TUNE_SAMPLES / 2; i++) samples[i] = samples[i << 1];
+              sample_count = MPC_TUNE_SAMPLES / 2;
+              sample_interval <<= 1;
+            }
+            samples[sample_count++] = currentTemp;
+            next_sample_ms += sample_interval;
+          }
+          if (currentTemp >= temp) {
+            act->soft_pwm = 0;
+
+            // Fit from 30% of the rise on, skipping the start delayed by the sensor
+            uint8_t i0 = 0;
+            while (i0 < sample_count - 1 && samples[i0] < ambient_temp + 0.3 * (temp - ambient_temp)) i0++;
+            const uint8_t k = (sample_count - 1 - i0) >> 1;
+            const float T1 = samples[sample_count - 1 - (k << 1)],
+                        T2 = samples[sample_count - 1 - k],
+                        T3 = samples[sample_count - 1],
+                        denom = T1 + T3 - 2.0 * T2;
+
+            if (k < 2 || denom >= 0.0 || T3 <= T2 || T2 <= T1) {
+              SERIAL_LM(ER, "Model autotune failed, heating curve not exponential");
+              wait_for_heatup = false;
+              break;
+            }
+
+            const float tau = k * sample_interval * 0.001 / LOG((T2 - T1) / (T3 - T2)),
+                        asymptote = (T1 * T3 - T2 * T2) / denom;
+
+            act->mpc_ambient_xfer_coeff = full_power / (asymptote - ambient_temp);
+            act->mpc_block_heat_capacity = act->mpc_ambient_xfer_coeff * tau;
+            act->mpc_ambient_xfer_coeff_fan = act->mpc_ambient_xfer_coeff;
+
+            SERIAL_MV("Time constant: ", tau);
+            SERIAL_EMV(" Asymptote: ", asymptote);
+
+            act->target_temperature = temp;
+            act->mpc_model_temp = currentTemp;
+            act->mpc_ambient_temp = ambient_temp;
+            next_tick_ms = state_ms = ms;
+            state = MPCSettle;
+          }
+          break;
+
+        default:
+          // Hold the target at the control period
+          if (ELAPSED(ms, next_tick_ms)) {
+            next_tick_ms += 100UL;
+            calc_mpc_e_rate();
+            act->soft_pwm = get_mpc_output(h);
+            // The ambient tracker would absorb the losses being measured
+            act->mpc_ambient_temp = ambient_temp;
+
+            if (state == MPCSettle) {
+              if (ELAPSED(ms, state_ms + 30000UL)) {
+                SERIAL_EM("Measuring losses, part fan off");
+                state = MPCHoldFanOff;
+              }
+            }
+            else {
+              sum_temp += currentTemp;
+              sum_power += act->soft_pwm * (1.0 / 255.0) * act->mpc_heater_power;
+              if (++hold_ticks == 200) {
+                const float xfer = sum_power / (sum_temp - hold_ticks * ambient_temp);
+                sum_temp = sum_power = 0.0;
+                hold_ticks = 0;
+                if (state == MPCHoldFanOff) {
+                  act->mpc_ambient_xfer_coeff = act->mpc_ambient_xfer_coeff_fan = xfer;
+                  #if MPC_FAN_INDEX >= 0
+                    SERIAL_EM("Measuring losses, part fan on");
+                    fans[MPC_FAN_INDEX].Speed = 255;
+                    state = MPCHoldFanOn;
+                  #else
+                    tuned = true;
+                  #endif
+                }
+                else {
+                  act->mpc_ambient_xfer_coeff_fan = xfer;
+                  tuned = true;
+                }
+              }
+            }
+          }
+          break;
+      }
+
+      if (tuned) break;
+
+      #if ENABLED(NEXTION)
+        lcd_key_touch_update();
+      #else
+        lcd_update();
+      #endif
+    }
+
+    disable_all_heaters();
+
+    #if MPC_FAN_INDEX >= 0
+      fans[MPC_FAN_INDEX].Speed = old_fan_speed;
+    #endif
+
+    if (tuned) {
+      SERIAL_EM(MSG_PID_AUTOTUNE_FINISHED);
+      SERIAL_EMV("MPC_HEATER_POWER ", act->mpc_heater_power);
+      SERIAL_EMV("MPC_BLOCK_HEAT_CAPACITY ", act->mpc_block_heat_capacity);
+      SERIAL_EMV("MPC_AMBIENT_XFER_COEFF ", act->mpc_ambient_xfer_coeff, 4);
+      SERIAL_EMV("MPC_AMBIENT_XFER_COEFF_FAN ", act->mpc_ambient_xfer_coeff_fan, 4);
+      if (storeValues) {
+        eeprom.Store_Settings();
+        return;
+      }
+    }
+
+    // Not applied, back to the previous model
+    act->mpc_heater_power = old_power;
+    act->mpc_block_heat_capacity = old_capacity;
+    act->mpc_ambient_xfer_coeff = old_xfer;
+    act->mpc_ambient_xfer_coeff_fan = old_xfer_fan;
+  }
+
+#endif // MPC_HOTEND
+
+void Temperature::tune_init(pid_tune_t &tune, Heater *act, const float temp) {
+  tune.act      = act;
+  tune.temp     = temp;
+  tune.maxTemp  = 0.0;
+  tune.minTemp  = 10000.0;
+  tune.Kp = tune.Ki = tune.Kd = 0.0;
+  tune.t1 = tune.t2 = millis();
+  tune.t_high   = tune.t_low = 0;
+  tune.bias     = tune.d = act->pid_max >> 1;
+  tune.cycles   = 0;
+  tune.heating  = true;
+  tune.done     = false;
+}
+
+/**
+ * Print the M303 H index of the heater in front of the lines
+ * of a tune with more heaters
+ */
+void Temperature::tune_print_heater(const Heater *act) {
+  switch (act->type) {
+    case IS_BED:      SERIAL_MSG("H-1:"); break;
+    case IS_CHAMBER:  SERIAL_MSG("H-2:"); break;
+    case IS_COOLER:   SERIAL_MSG("H-3:"); break;
+    default:          SERIAL_MV("H", (int)(act - heaters)); SERIAL_CHR(':'); break;
+  }
+}
+
+/**
+ * One step of the relay of a heater.
+ * Return false when the tune of the heater is done or failed.
+ */
+bool Temperature::tune_step(pid_tune_t &tune, const millis_t ms, const uint8_t ncycles, const uint8_t method, const bool multi) {
+
+  Heater * const act = tune.act;
+  const float currentTemp = act->current_temperature,
+              temp = tune.temp;
+  const uint8_t pidMax = act->pid_max;
+
+  NOLESS(tune.maxTemp, currentTemp);
+  NOMORE(tune.minTemp, currentTemp);
+
+  if (tune.heating && currentTemp > temp) {
+    if (ELAPSED(ms, tune.t2 + 2500UL)) {
+      tune.heating = false;
+
+      act->soft_pwm = (tune.bias - tune.d);
+
+      tune.t1 = ms;
+      tune.t_high = tune.t1 - tune.t2;
+
+      #if HAS_TEMP_COOLER
+        if (act->type == IS_COOLER)
+          tune.minTemp = temp;
+        else
+      #endif
+        tune.maxTemp = temp;
+    }
+  }
+
+  if (!tune.heating && currentTemp < temp) {
+    if (ELAPSED(ms, tune.t1 + 5000UL)) {
+      tune.heating = true;
+      tune.t2 = ms;
+      tune.t_low = tune.t2 - tune.t1;
+      if (tune.cycles > 0) {
+
+        tune.bias += (tune.d * (tune.t_high - tune.t_low)) / (tune.t_low + tune.t_high);
+        tune.bias = constrain(tune.bias, 20, pidMax - 20);
+        tune.d = (tune.bias > pidMax / 2) ? pidMax - 1 - tune.bias : tune.bias;
+
+        if (multi) tune_print_heater(act);
+        SERIAL_MV(MSG_BIAS, tune.bias);
+        SERIAL_MV(MSG_D, tune.d);
+        SERIAL_MV(MSG_T_MIN, tune.minTemp);
+        SERIAL_EMV(MSG_T_MAX, tune.maxTemp);
+        if (tune.cycles > 2) {
+          const float Ku = (4.0 * tune.d) / (M_PI * (tune.maxTemp - tune.minTemp)),
+                      Tu = ((float)(tune.t_low + tune.t_high) * 0.001);
+          if (multi) tune_print_heater(act);
+          SERIAL_MV(MSG_KU, Ku);
+          SERIAL_EMV(MSG_TU, Tu);
+
+          if (method == 0) {
+            tune.Kp = 0.6 * Ku;
+            tune.Ki = 2.0 * tune.Kp / Tu;
+            tune.Kd = tune.Kp * Tu * 0.125;
+            if (!multi) SERIAL_EM(MSG_CLASSIC_PID);
+          }
+          else if (method == 1) {
+            tune.Kp = 0.33 * Ku;
+            tune.Ki = 2.0 * tune.Kp / Tu;
+            tune.Kd = tune.Kp * Tu / 3.0;
+            if (!multi) SERIAL_EM(MSG_SOME_OVERSHOOT_PID);
+          }
+          else if (method == 2) {
+            tune.Kp = 0.2 * Ku;
+            tune.Ki = 2.0 * tune.Kp / Tu;
+            tune.Kd = tune.Kp * Tu / 3.0;
+            if (!multi) SERIAL_EM(MSG_NO_OVERSHOOT_PID);
+          }
+          else if (method == 3) {
+            tune.Kp = 0.7 * Ku;
+            tune.Ki = 2.5 * tune.Kp / Tu;
+            tune.Kd = tune.Kp * Tu * 3.0 / 20.0;
+            if (!multi) SERIAL_EM(MSG_PESSEN_PID);
+          }
+          if (!multi) {
+            SERIAL_EMV(MSG_KP, tune.Kp);
+            SERIAL_EMV(MSG_KI, tune.Ki);
+            SERIAL_EMV(MSG_KD, tune.Kd);
+          }
+        }
+      }
+
+      act->soft_pwm = (tune.bias + tune.d);
+
+      tune.cycles++;
+
+      #if HAS_TEMP_COOLER
+        if (act->type == IS_COOLER)
+          tune.maxTemp = temp;
+        else
+      #endif
+        tune.minTemp = temp;
+    }
+  }
+
+  #define MAX_OVERSHOOT_PID_AUTOTUNE 40
+  if (currentTemp > temp + MAX_OVERSHOOT_PID_AUTOTUNE
+    #if HAS_TEMP_COOLER
+      && act->type != IS_COOLER
+    #endif
+  ) {
+    SERIAL_STR(ER);
+    if (multi) tune_print_heater(act);
+    SERIAL_EM(MSG_PID_TEMP_TOO_HIGH);
+    return false;
+  }
+  #if HAS_TEMP_COOLER
+    else if (currentTemp < temp - MAX_OVERSHOOT_PID_AUTOTUNE && act->type == IS_COOLER) {
+      SERIAL_STR(ER);
+      if (multi) tune_print_heater(act);
+      SERIAL_EM(MSG_PID_TEMP_TOO_LOW);
+      return false;
+    }
+  #endif
+
+  // Timeout after 20 minutes since the last undershoot/overshoot cycle
+  if (((ms - tune.t1) + (ms - tune.t2)) > (20L * 60L * 1000L)) {
+    if (multi) tune_print_heater(act);
+    SERIAL_EM(MSG_PID_TIMEOUT);
+    return false;
+  }
+
+  if (tune.cycles > ncycles) {
+
+    if (multi) tune_print_heater(act);
+    SERIAL_EM(MSG_PID_AUTOTUNE_FINISHED);
+
+    #if (PIDTEMP)
+      if (act->type == IS_HOTEND) {
+        if (multi) tune_print_heater(act);
+        SERIAL_MV(MSG_KP, tune.Kp);
+        SERIAL_MV(MSG_KI, tune.Ki);
+        SERIAL_EMV(MSG_KD, tune.Kd);
+      }
+    #endif
+
+    #if (PIDTEMPBED)
+      if (act->type == IS_BED) {
+        SERIAL_EMV("#define DEFAULT_bedKp ", tune.Kp);
+        SERIAL_EMV("#define DEFAULT_bedKi ", tune.Ki);
+        SERIAL_EMV("#define DEFAULT_bedKd ", tune.Kd);
+      }
+    #endif
+
+    #if (PIDTEMPCHAMBER)
+      if (act->type == IS_CHAMBER) {
+        SERIAL_EMV("#define DEFAULT_chamberKp ", tune.Kp);
+        SERIAL_EMV("#define DEFAULT_chamberKi ", tune.Ki);
+        SERIAL_EMV("#define DEFAULT_chamberKd ", tune.Kd);
+      }
+    #endif
+
+    #if (PIDTEMPCOOLER)
+      if (act->type == IS_COOLER) {
+        SERIAL_EMV("#define DEFAULT_coolerKp ", tune.Kp);
+        SERIAL_EMV("#define DEFAULT_coolerKi ", tune.Ki);
+        SERIAL_EMV("#define DEFAULT_coolerKd ", tune.Kd);
+      }
+    #endif
+
+    tune.done = true;
+    return false;
+  }
+
+  return true;
+}
+
+/**
+ * Run the relays of count heaters until all are done,
+ * failed or stopped with M108
+ */
+void Temperature::tune_run(pid_tune_t tune[], const uint8_t count, const uint8_t ncycles, const uint8_t method, const bool storeValues) {
+
+  const bool multi = count > 1;
+  uint8_t running = count;
+  bool running_mask[HEATER_COUNT];
+  millis_t next_temp_ms = millis();
+
+  disable_all_heaters(); // switch off all heaters.
+
+  for (uint8_t i = 0; i < count; i++) {
+    tune[i].act->soft_pwm = tune[i].act->pid_max;
+    running_mask[i] = true;
+  }
+
+  wait_for_heatup = true;
+
+  // PID Tuning loop
+  while (wait_for_heatup && running) {
+
+    const millis_t ms = millis();
+
+    updateTemperaturesFromRawValues();
+
+    #if FAN_COUNT > 0
+      LOOP_FAN() fans[f].Check();
+    #endif
+
+    for (uint8_t i = 0; i < count; i++) {
+      if (running_mask[i] && !tune_step(tune[i], ms, ncycles, method, multi)) {
+        tune[i].act->soft_pwm = 0;
+        running_mask[i] = false;
+        running--;
+      }
+    }
+
+    // Every 2 seconds...
+    if (ELAPSED(ms, next_temp_ms)) {
+      print_heaters_state();
+      SERIAL_EOL();
+      next_temp_ms = ms + 2000UL;
+    }
+
+    #if ENABLED(NEXTION)
+      lcd_key_touch_update();
+    #else
+      lcd_update();
+    #endif
+
+  }
+
+  disable_all_heaters();
+
+  if (storeValues) {
+    bool stored = false;
+    for (uint8_t i = 0; i < count; i++) {
+      if (tune[i].done) {
+        tune[i].act->Kp = tune[i].Kp;
+        tune[i].act->Ki = tune[i].Ki;
+        tune[i].act->Kd = tune[i].Kd;
+        stored = true;
+      }
+    }
+    if (stored) {
+      updatePID();
+      eeprom.Store_Settings();
+    }
+  }
+}
+
 // Temperature Error Handlers
 void Temperature::_temp_error(const uint8_t h, const char * const serial_msg, const char * const lcd_msg) {
   static bool killed = false;
@@ -27,6 +27,11 @@
 #ifndef _TEMPERATURE_H_
 #define _TEMPERATURE_H_
 
+#if ENABLED(HEATER_CONTROL_SCHEDULER)
+  // A heater isn't controlled faster than its sensor is read
+  #define HEATER_CONTROL_MIN_PERIOD ((HAL_ADC_REFRESH_MS) > 10 ? (uint16_t)(HAL_ADC_REFRESH_MS) : 10)
+#endif
+
 class Temperature {
 
   public: /** Constructor */
@@ -37,6 +42,10 @@ class Temperature {
 
     static volatile bool wait_for_heatup;
 
+    #if ENABLED(ASYNC_HEATER_WAIT)
+      static bool async_wait;   // Heater waits are deferred to the next dependent command
+    #endif
+
     #if HAS_MCU_TEMPERATURE
       static float    mcu_current_temperature,
                       mcu_highest_temperature,
@@ -86,10 +95,18 @@ class Temperature {
       static int    lpq_ptr;
     #endif
 
+    #if ENABLED(MPC_HOTEND)
+      static float  mpc_e_rate[HOTENDS];
+    #endif
+
     static uint8_t pid_pointer[HEATER_COUNT];
 
     static millis_t next_check_ms[HEATER_COUNT];
 
+    #if ENABLED(HEATER_CONTROL_SCHEDULER)
+      static millis_t last_control_ms[HEATER_COUNT];
+    #endif
+
     #if ENABLED(FILAMENT_SENSOR)
       static int8_t   meas_shift_index;     // Index of a delayed sample in buffer
       static uint16_t current_raw_filwidth; // Measured filament diameter - one extruder only
@@ -99,6 +116,11 @@ class Temperature {
       static bool paused;
     #endif
 
+    #if ENABLED(ASYNC_HEATER_WAIT)
+      static uint8_t  wait_pending,         // Bit per heater with a deferred wait
+                      wait_cooling;         // Bit per heater waiting for cooling too
+    #endif
+
   public: /** Public Function */
 
     void init();
@@ -108,6 +130,18 @@ class Temperature {
      */
     static void wait_heater(Heater *act, bool no_wait_for_cooling=true);
 
+    /**
+     * Wait for a heater from M109, M190, M191 and M192
+     * With async_wait on the wait is deferred to the next dependent command
+     */
+    static void wait_heater_command(Heater *act, const bool no_wait_for_cooling);
+
+    #if ENABLED(ASYNC_HEATER_WAIT)
+      static bool heater_wait_pending() { return wait_pending != 0; }
+      static void wait_pending_heaters();
+      static void cancel_pending_heaters() { wait_pending = wait_cooling = 0; }
+    #endif
+
     /**
      * Called from the Temperature ISR
      */
@@ -118,11 +152,25 @@ class Temperature {
      */
     static void spin();
 
+    #if ENABLED(HEATER_CONTROL_SCHEDULER)
+      /**
+       * Run the PID of the heaters with an elapsed control period.
+       * Called from the idle loop.
+       */
+      static void control();
+    #endif
+
     /**
      * Perform auto-tuning for hotend, bed, chamber or cooler in response to M303
+     * With MPC_HOTEND method 4 measures the thermal model of a hotend
      */
     static void PID_autotune(Heater *act, const float temp, const uint8_t ncycles, const uint8_t method, const bool storeValues=false);
 
+    /**
+     * Perform auto-tuning for all the PID hotends, bed and chamber at the same time in response to M303 A
+     */
+    static void PID_autotune_all(const float hotend_temp, const float bed_temp, const float chamber_temp, const uint8_t ncycles, const uint8_t method, const bool storeValues=false);
+
     /**
      * Update the temp manager when PID values change
      */
@@ -160,7 +208,33 @@ class Temperature {
       static float analog2tempMCU(const int raw);
     #endif
 
-    static uint8_t get_pid_output(const uint8_t h);
+    static uint8_t get_pid_output(const uint8_t h, const float dt=0.1);
+
+    // Relay state of a heater in PID autotune
+    typedef struct {
+      Heater    *act;
+      float     temp,
+                maxTemp,
+                minTemp,
+                Kp, Ki, Kd;
+      millis_t  t1, t2;
+      int32_t   t_high, t_low,
+                bias, d;
+      uint8_t   cycles;
+      bool      heating,
+                done;
+    } pid_tune_t;
+
+    static void tune_init(pid_tune_t &tune, Heater *act, const float temp);
+    static void tune_print_heater(const Heater *act);
+    static bool tune_step(pid_tune_t &tune, const millis_t ms, const uint8_t ncycles, const uint8_t method, const bool multi);
+    static void tune_run(pid_tune_t tune[], const uint8_t count, const uint8_t ncycles, const uint8_t method, const bool storeValues);
+
+    #if ENABLED(MPC_HOTEND)
+      static void calc_mpc_e_rate();
+      static uint8_t get_mpc_output(const uint8_t h, const float dt=0.1);
+      static void MPC_autotune(Heater *act, const float temp, const bool storeValues);
+    #endif
 
     static void _temp_error(const uint8_t h, const char * const serial_msg, const char * const lcd_msg);
     static void min_temp_error(const uint8_t h);